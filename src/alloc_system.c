@@ -13,515 +13,231 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+
 #include "alloc_system.h"
 
 /* A function to allocate memory for the problem reading the input from a reaction list */
-/* all relevant stoichiometric information has been previously stored in a "metabolite_parse" structure*/
-void alloc_from_filetype2 (metabolite *system, double *s, metabolite_parse *data, int Nmet, FILE *outfile){
+/* reactions are columns: their entries are collected in a list, which is turned into rows once the file is over */
+void alloc_from_filetype2 (file_wrapper *input_file, network *net){
+    
+    span line;
+    int which_r = 0;
+    
+    /* the names of the metabolites, for a constant time lookup */
+    metabolite_index index;
+    
+    entry_list entries;
     
-    metabolite *dummy;
-    metabolite_parse *parser;
-    int *which, cnt;
-    double *coeff;
+    /* the scratch memory of the parser, freed at once when the rows are built */
+    arena scratch;
     
-    dummy = system;
+    arena_init (&scratch, ARENA_BLOCK);
     
-    /* loop over the stored data*/
-    for ( parser = data; parser < data + Nmet; parser++) {
+    metabolite_index_init (&index, &scratch, input_file -> initial_n);
+    
+    entry_list_alloc (&entries, &scratch, 4 * input_file -> initial_n);
+    
+    /* for all file lines */
+    while ( next_input_line (input_file, &line) ){
+        
+        /* only read reactions, i.e. lines featuring the ">" of the arrow */
+        if ( !is_data_line (line) || span_find (line, '>') == NULL ) continue;
         
-        /* get the # of reactions where dummy metabolite appears as an input */
-        dummy -> input.n_react = parser -> input.n_react;
+        /* parse the line as reaction which_r */
+        parse_react_line (line, which_r, &index, &entries);
         
-        /* allocate memory for reaction/coefficients pointers */
-        dummy -> input.react = (double **) malloc( dummy -> input.n_react * sizeof ( double *) );
+        which_r++;
+    }
+    
+    /* build the rows */
+    network_from_entries (net, &entries, index.n_used, which_r);
+    
+    arena_free (&scratch);
+}
+
+/* A function to close row i of the network: the inputs are already in, the outputs are held in a list */
+void append_row (network *net, int i, entry_list *outputs){
+    
+    int k;
+    
+    /* the outputs of the row begin here */
+    network_split_row (net, i);
+    
+    for (k = 0; k < outputs -> n; k++) network_add_entry (net, *(outputs -> col + k), *(outputs -> coeff + k));
+    
+    /* close the row */
+    network_end_row (net, i);
+    
+    /* the list is ready for the next row */
+    outputs -> n = 0;
+}
+
+/* A function to allocate memory for the problem reading the input from a stoichiometric matrix */
+/* each line is read once: inputs go straight into the network, outputs wait in a list until the line is over */
+/* return 0 if the lines do not all have the same number of columns, i.e. the file is no matrix */
+int alloc_from_filetype1 (file_wrapper *input_file, network *net){
+  
+    span line, token;
+    const char *colon;
+    int i = 0, n, n_columns0 = -1;
+    double c;
+    entry_list outputs;
+    
+    /* the outputs of a line are held in a small arena of their own */
+    arena scratch;
+    
+    arena_init (&scratch, ARENA_BLOCK);
+    
+    entry_list_alloc (&outputs, &scratch, 16);
+    
+    /* for all file lines */
+    while ( next_input_line (input_file, &line) ){
+        
+        /* only read if it is not a comment */
+        if ( !is_data_line (line) ) continue;
         
-        dummy -> input.coeff = (double *) malloc( dummy -> input.n_react * sizeof ( double ) );
+        /* a descriptor of the line may be present with a ":" sign to separate */
+        colon = span_find (line, ':');
         
-        /* for each reaction, get memory position and coefficient */
-        coeff = parser -> input.coeff;
+        /* if there is a ":", ignore whatever comes before it */
+        if (colon != NULL) line.begin = colon + 1;
         
-        /* loop over the "metabolite_parse" to get the reactions attached to metabolite dummy */
-        cnt = 0;
-        for (which=parser -> input.which_r; which < parser -> input.which_r + parser -> input.n_react; which++) {
+        /* for each column of the line, i.e. reaction n */
+        n = 0;
+        
+        while ( span_next_token (&line, &token) ){
             
+            /* get the stoichiometric coefficient */
+            c = span_to_double (token);
             
-            /* assign pointer to reaction */
-            *( dummy -> input.react + cnt ) = s + (*which);
+            /* inputs (negative coefficients) are stored right away, outputs (positive coefficients) later */
+            if ( c < 0. ) network_add_entry (net, n, c);
             
-            /* assign coefficient value */
-            *( dummy -> input.coeff + cnt ) = *coeff;
+            else if ( c > 0. ) entry_list_add (&outputs, i, n, c);
             
-            coeff++;
-            cnt++;
+            n++;
         }
         
-        /* get the # of reactions where dummy metabolite appears as an ouptut */
-        dummy -> output.n_react = parser -> output.n_react;
-        
-        /* allocate memory for reaction/coefficients pointers */
-        dummy -> output.react = (double **) malloc( dummy -> output.n_react * sizeof ( double *) );
-        
-        dummy -> output.coeff = (double *) malloc( dummy -> output.n_react * sizeof ( double ) );
+        /* the number of columns of the first line is the number of reactions, and it may not change */
+        if ( n_columns0 < 0 ) n_columns0 = n;
         
-        /* for each reaction, get memory position and coefficient */
-        coeff = parser -> output.coeff;
-        
-        /* loop over the "metabolite_parse" to get the reactions attached to metabolite dummy */
-        cnt = 0;
-        for (which=parser -> output.which_r; which < parser -> output.which_r + parser -> output.n_react; which++) {
-            
-            
-            /* assign pointer to reaction */
-            *( dummy -> output.react + cnt ) = s + (*which);
+        else if ( n != n_columns0 ){
             
-            /* assign coefficient value */
-            *( dummy -> output.coeff + cnt ) = *coeff;
+            arena_free (&scratch);
             
-            coeff++;
-            cnt++;
+            return 0;
         }
-
-        /* increase dummy to next metabolite */
-        dummy++;
+        
+        append_row (net, i, &outputs);
+        
+        /* get to the next metabolite */
+        i++;
     }
     
+    net -> Nreact = n_columns0 > 0 ? n_columns0 : 0;
+    
+    arena_free (&scratch);
+    
+    return 1;
 }
 
-/* A function to allocate memory for the problem reading the input from a stoichiometric matrix */
-/* all relevant stoichiometric information is stored in a string named "file_content" */
-void alloc_from_filetype1(char *file_content, metabolite *mets, int Nmet, double *s, FILE *outfile){
-  
-    char *s1 = file_content, *colon, *s2, *s3;
-    int n;
-    double **react_in, **react_out, *coeff_in, *coeff_out, c;
-    metabolite *dummy = mets;
+/* A function to allocate memory for the problem reading the input from an adjacency list */
+/* even columns are reaction indices (from 1), odd ones coefficients */
+/* each line is read once: inputs go straight into the network, outputs wait in a list until the line is over */
+void alloc_from_filetype0 (file_wrapper *input_file, network *net){
     
-    /* separate the file_content string per lines */
-    while ( strchr(s1, '\n') != NULL ){
-        
-        /* get a pointer to the end of line */
-        s2 = strchr(s1, '\n');
+    span line, token;
+    const char *colon;
+    int i = 0, n, which = 0, max_react = 0;
+    double c;
+    entry_list outputs;
+    
+    /* the outputs of a line are held in a small arena of their own */
+    arena scratch;
+    
+    arena_init (&scratch, ARENA_BLOCK);
+    
+    entry_list_alloc (&outputs, &scratch, 16);
+    
+    /* for all file lines */
+    while ( next_input_line (input_file, &line) ){
         
         /* only read if it is not a comment */
-        if ( *s1 != '#'){
-            
-            /* a descriptor of the line may be present with a ":" sign to separate */
-            colon = strchr(s1, ':');
-            
-            /* if there is a ":", ignore whatever comes before it */
-            if (colon != NULL ){
-                
-                s1 = colon + 1;
-                
-            }
-            
-            /* get rid of trailing space */
-            while (*s1 == ' ') s1++;
-            
-            /* store a pointer to the beginning of line */
-            colon = s1;
-            
-            /* keep track of everything in the log file*/
-            fprintf(outfile, "Allocating metabolite %d... ", (int)(dummy - mets) + 1); fflush(outfile);
-            
-            /* set a null sign at the end of line to stop reading there */
-            *s2 = '\0';
-            
-            /* initialise the number of i/o reactions for metabolite dummy */
-            dummy -> input.n_react = 0;
-            
-            dummy -> input.n_react = 0;
-            
-            /* for each column of the line */
-            while ( strchr(s1, ' ') != NULL ){
-                
-                /* get to the next space */
-                s3 = strchr(s1, ' ');
-                
-                /* stop the string there */
-                *s3 = '\0';
-                
-                /* get the stoichiometric coefficient */
-                c = atof(s1);
-                
-                /* if negative, increase the # of reaction where dummy appears as input */
-                if (c < 0. ) dummy -> input.n_react++;
-                
-                /* if positive, increase the # of reaction where dummy appears as output */
-                if (c > 0. ) dummy -> output.n_react++;
-                
-                /* undo the null sign */
-                *s3 = ' ';
-                
-                /* keep reading */
-                s1 = s3 + 1;
-            }
-            
-            /* for the last column */
-            /* get the stoichiometric coefficient */
-            c = atof(s1);
-            
-            /* if negative, increase the # of reaction where dummy appears as input */
-            if (c < 0. ) dummy -> input.n_react++;
-            
-            /* if positive, increase the # of reaction where dummy appears as output */
-            if (c > 0. ) dummy -> output.n_react++;
-            
-            /* allocate memory for reaction/coefficients pointers */
-            dummy -> input.react = (double **) malloc( dummy -> input.n_react * sizeof ( double *) );
-            
-            dummy -> input.coeff = (double *) malloc( dummy -> input.n_react * sizeof ( double ) );
-            
-            /* allocate memory for reaction/coefficients pointers */
-            dummy -> output.react = (double **) malloc( dummy -> output.n_react * sizeof ( double *) );
-            
-            dummy -> output.coeff = (double *) malloc( dummy -> output.n_react * sizeof ( double ) );
-            
-            /* get back to the beginning of line and assign now reactions & coefficients to dummy */
-            s1 = colon;
-            
-            /* an index to keep track of the matrix column i.e. reaction index*/
-            n = 0;
-            
-            /* initialise pointers to reactions and coefficients */
-            react_in = dummy -> input.react;
-            
-            react_out = dummy -> output.react;
-            
-            coeff_in = dummy -> input.coeff;
-            
-            coeff_out = dummy -> output.coeff;
-            
-            /* read again per column */
-            while ( strchr(s1, ' ') != NULL ){
-                
-                /* get to the next space */
-                s3 = strchr(s1, ' ');
-                
-                /* stop the string there */
-                *s3 = '\0';
-                
-                /* get the stoichiometric coefficient */
-                c = atof(s1);
-                
-                /* if negative */
-                if (c < 0. ) {
-                    
-                    /* associate reaction input pointer to the corresponding reaction (via column n) */
-                    *react_in = s + n;
-                    
-                    /* associate coefficient to the right one (coefficients are all positive in minOver) */
-                    *coeff_in = -c;
-                    
-                    /* increase pointer to input reactions */
-                    react_in++;
-                    
-                    /* increase pointer to input coefficients */
-                    coeff_in++;
-                    
-                }
-                
-                /* if positive */
-                if (c > 0. ) {
-                    
-                    /* associate reaction output pointer to the corresponding reaction (via column n) */
-                    *react_out = s + n;
-                    
-                    /* associate coefficient to the right one */
-                    *coeff_out = c;
-                    
-                    /* increase pointer to output reactions */
-                    react_out++;
-                    
-                    /* increase pointer to output coefficients */
-                    coeff_out++;
-                    
-                }
-                
-                /* undo the null sign */
-                *s3 = ' ';
-                
-                /* keep reading */
-                s1 = s3 + 1;
-                
-                /* increase the column (reaction) index */
-                n++;
-            }
-            
-            /* for the last column */
-            /* get the stoichiometric coefficient */
-            c = atof(s1);
+        if ( !is_data_line (line) ) continue;
+        
+        /* a descriptor of the line may be present with a ":" sign to separate */
+        colon = span_find (line, ':');
+        
+        /* if there is a ":", ignore whatever comes before it */
+        if (colon != NULL) line.begin = colon + 1;
+        
+        /* for each column of the line */
+        n = 0;
+        
+        while ( span_next_token (&line, &token) ){
             
-            /* if negative */
-            if (c < 0. ) {
-                
-                /* associate inputs as above */
-                *react_in = s + n;
-                
-                *coeff_in = -c;
+            /* if even column, get reaction index, the largest is the number of reactions */
+            if (n %2 == 0){
                 
-                react_in++;
-                
-                coeff_in++;
+                which = (int) span_to_long (token);
                 
+                if ( which > max_react ) max_react = which;
             }
             
-            /* if positive */
-            if (c > 0. ) {
-                
-                /* associate outputs as above */
-                *react_out = s + n;
-                
-                *coeff_out = c;
+            /* if odd column, store inputs right away and outputs later */
+            else{
                 
-                react_out++;
+                c = span_to_double (token);
                 
-                coeff_out++;
+                if ( c < 0. ) network_add_entry (net, which - 1, c);
                 
+                else if ( c > 0. ) entry_list_add (&outputs, i, which - 1, c);
             }
             
-            /* undo the null sign at the end of line */
-            *s2 = '\n';
-            
-            /* keep track of everything in the log file */
-            fprintf(outfile, "Done.\n"); fflush(outfile);
-            
-            /* increase pointer to metabolites */
-            dummy++;
-
+            n++;
         }
         
-        /* get to the next line */
-        s1 = s2 +1;
+        append_row (net, i, &outputs);
         
+        /* get to the next metabolite */
+        i++;
     }
     
+    net -> Nreact = max_react;
+    
+    arena_free (&scratch);
 }
 
-/* A function to allocate memory for the problem reading the input from an adjacency list */
-/* all relevant stoichiometric information is stored in a string named "file_content" */
-void alloc_from_filetype0(char *file_content, metabolite *mets, int Nmet, double *s, FILE *outfile){
+/* A function to allocate memory for the problem reading the input file once */
+/* the file type has been guessed by handle_input_file, the sizes of the problem are recorded in input_file */
+void alloc_system (file_wrapper *input_file, network *net, FILE *outfile){
     
-    char *s1 = file_content, *colon, *s2, *s3;
-    int n, which;
-    double **react_in, **react_out, *coeff_in, *coeff_out, c;
-    metabolite *dummy = mets;
-    
-    /* separate the file_content string per lines */
-    while ( strchr(s1, '\n') != NULL ){
+    /* if input data is a stoichiometric matrix */
+    if ( input_file -> filetype == 1 ) {
         
-        /* get a pointer to the end of line */
-        s2 = strchr(s1, '\n');
+        /* record it on the log file */
+        fprintf(outfile, "Allocating from stoichiometric matrix\n");
         
-        /* only read if it is not a comment */
-        if ( *s1 != '#'){
-            
-            /* a descriptor of the line may be present with a ":" sign to separate */
-            colon = strchr(s1, ':');
-            
-            /* if there is a ":", ignore whatever comes before it */
-            if (colon != NULL ){
-                
-                s1 = colon + 1;
-                
-            }
-            
-            /* get rid of trailing space */
-            while (*s1 == ' ') s1++;
-            
-            /* store a pointer to the beginning of line */
-            colon = s1;
-            
-            /* keep track of everything in the log file*/
-            fprintf(outfile, "Allocating metabolite %d... ", (int)(dummy - mets) + 1); fflush(outfile);
-            
-            /* set a null sign at the end of line to stop reading there */
-            *s2 = '\0';
-            
-            /* initialise the number of i/o reactions for metabolite dummy */
-            dummy -> input.n_react = 0;
-            
-            dummy -> output.n_react = 0;
-            
-            /* initialise the column index */
-            n = 0;
-            
-            /* for each column of the line */
-            while ( strchr(s1, ' ') != NULL ){
-                
-                /* get to the next space */
-                s3 = strchr(s1, ' ');
-                
-                /* stop the string there */
-                *s3 = '\0';
-                
-                /* get the number */
-                c = atof(s1);
-                
-                /* if negative and column odd, increase the # of reaction where dummy appears as input */
-                if (c < 0. && n%2 != 0) dummy -> input.n_react++;
-                
-                /* if positive and column odd, increase the # of reaction where dummy appears as output */
-                if (c > 0. && n%2 != 0) dummy -> output.n_react++;
-                
-                /* undo the null sign */
-                *s3 = ' ';
-                
-                /* keep reading */
-                s1 = s3 + 1;
-                
-                /* increase the column index */
-                n++;
-            }
-            
-            /* for the last column */
-            /* surely it cannot be a reaction index, so get the stoichiometric coefficient */
-            c = atof(s1);
-            
-            /* if negative, increase the # of reaction where dummy appears as input */
-            if (c < 0. ) dummy -> input.n_react++;
-            
-            /* if positive, increase the # of reaction where dummy appears as output */
-            if (c > 0. ) dummy -> output.n_react++;
-            
-            /* allocate memory for reaction/coefficients pointers */
-            dummy -> input.react = (double **) malloc( dummy -> input.n_react * sizeof ( double *) );
-            
-            dummy -> input.coeff = (double *) malloc( dummy -> input.n_react * sizeof ( double ) );
-            
-            /* allocate memory for reaction/coefficients pointers */
-            dummy -> output.react = (double **) malloc( dummy -> output.n_react * sizeof ( double *) );
-            
-            dummy -> output.coeff = (double *) malloc( dummy -> output.n_react * sizeof ( double ) );
-            
-            
-            /* get back to the beginning of line and assign now reactions & coefficients to dummy */
-            
-            s1 = colon;
-            
-            /* reinitialise the column index*/
-            n = 0;
-            
-            /* initialise pointers to reactions and coefficients */
-            react_in = dummy -> input.react;
-            
-            react_out = dummy -> output.react;
-            
-            coeff_in = dummy -> input.coeff;
-            
-            coeff_out = dummy -> output.coeff;
-            
-            /* read again per column */
-            while ( strchr(s1, ' ') != NULL ){
-                
-                /* get to the next space */
-                s3 = strchr(s1, ' ');
-                
-                /* stop the string there */
-                *s3 = '\0';
-                
-                /* if even column, get reaction index*/
-                if (n %2 == 0) which = atoi(s1);
-                
-                /* get a potential stoichiometric coefficient */
-                c = atof(s1);
-                
-                /* if negative and column odd */
-                if (c < 0. && n %2 != 0) {
-                    
-                    /* associate reaction output pointer to the corresponding reaction (via index which) */
-                    *react_in = s + which - 1;
-                    
-                    /* associate coefficient */
-                    *coeff_in = -c;
-                    
-                    /* increase pointer to input reactions */
-                    react_in++;
-                    
-                    /* increase pointer to input coefficients */
-                    coeff_in++;
-                    
-                }
-                
-                /* if positive and column odd */
-                if (c > 0. && n %2 != 0) {
-                    
-                    /* associate reaction output pointer to the corresponding reaction (via index which) */
-                    *react_out = s + which - 1;
-                    
-                    /* associate coefficient */
-                    *coeff_out = c;
-                    
-                    /* increase pointer to output reactions */
-                    react_out++;
-                    
-                    /* increase pointer to output coefficients */
-                    coeff_out++;
-                    
-                }
-                
-                /* undo the null sign */
-                *s3 = ' ';
-                
-                /* keep reading */
-                s1 = s3 + 1;
-                
-                /* increase the column index */
-                n++;
-            }
+        /* rows are added as they come, and so are entries */
+        network_alloc (net, 0, 0, 1024);
+        
+        /* if the lines turn out to have different lengths, read the file again as an adjacency list */
+        if ( alloc_from_filetype1 (input_file, net) == 0 ){
             
-            /* for the last column */
-            /* surely it cannot be a reaction index, so get the stoichiometric coefficient */
-            c = atof(s1);
+            fprintf(outfile, "Lines of different length: not a matrix\n");
             
-            /* if negative */
-            if (c < 0. ) {
-                
-                /* associate inputs as above */
-                *react_in = s + which - 1;
-                
-                *coeff_in = -c;
-                
-                react_in++;
-                
-                coeff_in++;
-                
-            }
+            network_free (net);
             
-            /* if positive */
-            if (c > 0. ) {
-                
-                /* associate outputs as above */
-                *react_out = s + which - 1;
+            if ( rewind_input (input_file) == 0 ){
                 
-                *coeff_out = c;
-                
-                react_out++;
-                
-                coeff_out++;
+                fprintf(stderr, "Cannot read the input file again as an adjacency list\n");
                 
+                exit (EXIT_FAILURE);
             }
             
-            /* undo the null sign at the end of line */
-            *s2 = '\n';
-            
-            /* keep track of everything in the log file */
-            fprintf(outfile, "Done.\n"); fflush(outfile);
-            
-            /* increase pointer to metabolites */
-            dummy++;
+            input_file -> filetype = 0;
         }
-        
-        /* get to the next line */
-        s1 = s2 +1;
     }
-
-    return;
-}
-
-/* A function to allocate memory for the problem once the input file has been read */
-/* the input data is stored in a structure called "file_wrapper" */
-void alloc_system (file_wrapper *input_file, metabolite *mets, int Nmet, double *s, FILE *outfile){
     
     /* if input data is an adjacency list */
     if ( input_file -> filetype == 0 ) {
@@ -529,19 +245,10 @@ void alloc_system (file_wrapper *input_file, metabolite *mets, int Nmet, double
         /* record it on the log file */
         fprintf(outfile, "Allocating from adjacency list\n");
         
-        /* use the corresponding function to allocate memory */
-        alloc_from_filetype0( input_file -> file_content, mets, Nmet, s, outfile);
+        /* rows are added as they come, and so are entries */
+        network_alloc (net, 0, 0, 1024);
         
-    }
-    
-    /* if input data is a stoichiometric matrix */
-    else if ( input_file -> filetype == 1 ) {
-        
-        /* record it on the log file */
-        fprintf(outfile, "Allocating from stoichiometric matrix\n");
-        
-        /* use the corresponding function to allocate memory */
-        alloc_from_filetype1( input_file -> file_content, mets, Nmet, s, outfile);
+        alloc_from_filetype0 (input_file, net);
     }
     
     /* if input data is a reaction list */
@@ -550,13 +257,11 @@ void alloc_system (file_wrapper *input_file, metabolite *mets, int Nmet, double
         /* record it on the log file */
         fprintf(outfile, "Allocating from reaction list\n");
         
-        /* use the corresponding function to allocate memory */
-        alloc_from_filetype2 (mets, s, input_file -> parser, Nmet, outfile);
-        
+        alloc_from_filetype2 (input_file, net);
     }
     
     /* else... */
-    else{
+    else if ( input_file -> filetype != 1 ){
         
         /* the input file is unkown, flag it out */
         fprintf(outfile," UNKNWON INPUT FILE TYPE\n");
@@ -566,74 +271,12 @@ void alloc_system (file_wrapper *input_file, metabolite *mets, int Nmet, double
         exit (EXIT_FAILURE);
     }
     
-}
-
-/* *** THIS FUNCTION IS NOT USED ANYMORE.... *** */
-/* A function to build the system to work with */
-void build_network (FILE *in_file, metabolite *metabs, double *s, int Nmet, FILE *log_file){
-    
-    metabolite *dummy;
-    int i, cnt;
-    double coeff;
-    
-    /* loop over meatbolites appearing as input */
-    for (dummy = metabs; dummy < metabs + Nmet; dummy++){
-        
-        fprintf(log_file, "Reading metabolite %d as input... ", (int)(dummy - metabs) ); fflush(log_file);
-        
-        /* get # reacs. where metabolit *dummy appears as input */
-        fscanf(in_file,"%d", &(dummy -> input.n_react) );
-        
-        /* allocate memory for reaction/coefficients pointers */
-        dummy -> input.react = (double **) malloc( dummy -> input.n_react * sizeof ( double *) );
-        
-        dummy -> input.coeff = (double *) malloc( dummy -> input.n_react * sizeof ( double ) );
-        
-        /* for each reaction, get memory position and coefficient */
-        for (cnt=0; cnt < dummy -> input.n_react; cnt++) {
-            
-            /* get reaction index & coefficient from file */
-            fscanf(in_file,"%d %lf", &i, &coeff);
-            
-            /* assign pointer to reaction */
-            *( dummy -> input.react + cnt ) = s + (i - 1);
-            
-            /* assign coefficient value */
-            *( dummy -> input.coeff + cnt ) = coeff;
-        }
-        
-        fprintf(log_file, "Done.\n"); fflush(log_file);
-    }
+    /* record the sizes of the problem */
+    input_file -> Nmet = net -> Nmet;
     
-    /* loop over over meatbolites appearing as output */
-    for (dummy = metabs; dummy < metabs + Nmet; dummy++){
-        
-        fprintf(log_file, "Reading metabolite %d as output... ", (int)(dummy - metabs) ); fflush(log_file);
-        
-        /* get # reacs. where metabolit *dummy appears as output */
-        fscanf(in_file,"%d", &(dummy -> output.n_react) );
-        
-        /* allocate memory for reaction/coefficients pointers */
-        dummy -> output.react = (double **) malloc( dummy -> output.n_react * sizeof ( double *) );
-        
-        dummy -> output.coeff = (double *) malloc( dummy -> output.n_react * sizeof ( double ) );
-        
-        /* for each reaction, get memory position and coefficient */
-        for (cnt=0; cnt < dummy -> output.n_react; cnt++) {
-            
-            /* get reaction index & coefficient from file */
-            fscanf(in_file,"%d %lf", &i, &coeff);
-            
-            /* assign pointer to reaction */
-            *( dummy -> output.react + cnt ) = s + (i - 1);
-            
-            /* assign coefficient value */
-            *( dummy -> output.coeff + cnt ) = coeff;
-        }
-        
-        fprintf(log_file, "Done.\n"); fflush(log_file);
-    }
+    input_file -> Nreact = net -> Nreact;
     
-    fprintf(log_file, "\n\n");
+    /* keep track of everything in the log file */
+    fprintf(outfile, "%d stoichiometric entries stored\n", net -> nnz);
     
 }
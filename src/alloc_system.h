@@ -19,20 +19,21 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 
 #include "metabolites.h"
 
 #include "file_wrapper.h"
 
-void alloc_from_filetype2 (metabolite *, double *, metabolite_parse *, int, FILE *);
+void alloc_from_filetype2 (file_wrapper *, network *);
 
-void alloc_from_filetype1(char *, metabolite *, int, double *, FILE *);
+void append_row (network *, int, entry_list *);
 
-void alloc_from_filetype0(char *, metabolite *, int, double *, FILE *);
+int alloc_from_filetype1 (file_wrapper *, network *);
 
-void alloc_system (file_wrapper *, metabolite *, int, double *, FILE *);
+void alloc_from_filetype0 (file_wrapper *, network *);
 
-void build_network (FILE *, metabolite *, double *, int, FILE *);
+void alloc_system (file_wrapper *, network *, FILE *);
 
 #endif
 
@@ -0,0 +1,204 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "arena.h"
+
+/* the size of the block header, rounded up so that the data that follow it are aligned */
+#define ARENA_HEADER ( (sizeof (arena_block) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN )
+
+/* the data of a block */
+#define ARENA_DATA(b) ( (char *) (b) + ARENA_HEADER )
+
+/* A function to initialise an empty arena, whose small allocations share blocks of block_size bytes */
+void arena_init (arena *mem, size_t block_size){
+    
+    mem -> head = NULL;
+    
+    mem -> current = NULL;
+    
+    mem -> last = NULL;
+    
+    mem -> block_size = block_size > 0 ? block_size : ARENA_BLOCK;
+}
+
+/* A function to get a new block of size bytes and put it at the head of the list */
+arena_block *arena_new_block (arena *mem, size_t size, int dedicated){
+    
+    arena_block *b = (arena_block *) malloc ( ARENA_HEADER + size );
+    
+    if ( b == NULL ){
+        
+        fprintf(stderr, "Out of memory (%lu bytes requested)\n", (unsigned long) (ARENA_HEADER + size) );
+        
+        exit (EXIT_FAILURE);
+    }
+    
+    b -> size = size;
+    
+    b -> used = 0;
+    
+    b -> dedicated = dedicated;
+    
+    /* link it */
+    b -> prev = NULL;
+    
+    b -> next = mem -> head;
+    
+    if ( mem -> head != NULL ) mem -> head -> prev = b;
+    
+    mem -> head = b;
+    
+    return b;
+}
+
+/* A function to find the block holding the large allocation p, NULL if p is a small allocation */
+arena_block *arena_find_block (arena *mem, void *p){
+    
+    arena_block *b;
+    
+    for (b = mem -> head; b != NULL; b = b -> next) if ( b -> dedicated && ARENA_DATA (b) == (char *) p ) return b;
+    
+    return NULL;
+}
+
+/* A function to allocate n bytes from the arena */
+void *arena_alloc (arena *mem, size_t n){
+    
+    char *p;
+    
+    /* round the size up, so that the next allocation is aligned too */
+    n = (n + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+    
+    /* a large allocation gets a block of its own */
+    if ( n > mem -> block_size / 4 ){
+        
+        arena_block *b = arena_new_block (mem, n, 1);
+        
+        b -> used = n;
+        
+        return ARENA_DATA (b);
+    }
+    
+    /* a small one is bumped from the shared block, a new one if the current is full */
+    if ( mem -> current == NULL || mem -> current -> used + n > mem -> current -> size ) mem -> current = arena_new_block (mem, mem -> block_size, 0);
+    
+    p = ARENA_DATA (mem -> current) + mem -> current -> used;
+    
+    mem -> current -> used += n;
+    
+    mem -> last = p;
+    
+    return p;
+}
+
+/* A function to allocate n zeroed bytes from the arena */
+void *arena_calloc (arena *mem, size_t n){
+    
+    void *p = arena_alloc (mem, n);
+    
+    memset (p, 0, n);
+    
+    return p;
+}
+
+/* A function to grow the allocation p of old_n bytes to n bytes, keeping its content (like realloc) */
+/* a large allocation is resized with its block, the last small one grows in place if there is room */
+/* otherwise a new allocation is made, and the old one is left to the arena */
+void *arena_grow (arena *mem, void *p, size_t old_n, size_t n){
+    
+    arena_block *b;
+    char *q;
+    size_t old_round = (old_n + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN, round = (n + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+    
+    if ( p == NULL ) return arena_alloc (mem, n);
+    
+    /* a large allocation: resize its block, and link it again if it moved */
+    b = arena_find_block (mem, p);
+    
+    if ( b != NULL ){
+        
+        b = (arena_block *) realloc (b, ARENA_HEADER + round);
+        
+        if ( b == NULL ){
+            
+            fprintf(stderr, "Out of memory (%lu bytes requested)\n", (unsigned long) (ARENA_HEADER + round) );
+            
+            exit (EXIT_FAILURE);
+        }
+        
+        b -> size = round;
+        
+        b -> used = round;
+        
+        if ( b -> prev != NULL ) b -> prev -> next = b;
+        
+        else mem -> head = b;
+        
+        if ( b -> next != NULL ) b -> next -> prev = b;
+        
+        return ARENA_DATA (b);
+    }
+    
+    /* the last small allocation, with room after it in the shared block */
+    if ( (char *) p == mem -> last && round <= mem -> block_size / 4 && (char *) p + round <= ARENA_DATA (mem -> current) + mem -> current -> size ){
+        
+        mem -> current -> used += round - old_round;
+        
+        return p;
+    }
+    
+    /* otherwise move it */
+    q = (char *) arena_alloc (mem, n);
+    
+    memcpy (q, p, old_n < n ? old_n : n);
+    
+    return q;
+}
+
+/* A function to give a large allocation back before the arena is freed, small ones are left alone */
+void arena_release (arena *mem, void *p){
+    
+    arena_block *b = p != NULL ? arena_find_block (mem, p) : NULL;
+    
+    if ( b == NULL ) return;
+    
+    /* unlink the block */
+    if ( b -> prev != NULL ) b -> prev -> next = b -> next;
+    
+    else mem -> head = b -> next;
+    
+    if ( b -> next != NULL ) b -> next -> prev = b -> prev;
+    
+    free (b);
+}
+
+/* A function to free all the memory of the arena at once, the arena can then be used again */
+void arena_free (arena *mem){
+    
+    arena_block *b, *next;
+    
+    for (b = mem -> head; b != NULL; b = next){
+        
+        next = b -> next;
+        
+        free (b);
+    }
+    
+    mem -> head = NULL;
+    
+    mem -> current = NULL;
+    
+    mem -> last = NULL;
+}
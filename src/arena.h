@@ -0,0 +1,79 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* the alignment of every allocation, enough for any basic type */
+#define ARENA_ALIGN 16
+
+/* the default size of the blocks shared by small allocations */
+#define ARENA_BLOCK 16384
+
+/* a block of memory owned by an arena, its data follow the header */
+typedef struct arena_block{
+    
+    /* the neighbouring blocks in the list of the arena */
+    struct arena_block *prev;
+    
+    struct arena_block *next;
+    
+    /* the bytes the block can hold, and the bytes in use */
+    size_t size;
+    
+    size_t used;
+    
+    /* 1 if the block holds a single large allocation, which can be resized or released on its own */
+    int dedicated;
+}arena_block;
+
+/* a region allocator: small allocations are bumped from shared blocks, large ones get a block each */
+/* nothing is freed on its own (but large blocks): everything goes at once with arena_free */
+typedef struct{
+    
+    /* all the blocks, the most recent first */
+    arena_block *head;
+    
+    /* the shared block small allocations are bumped from, NULL if there is none yet */
+    arena_block *current;
+    
+    /* the most recent small allocation, the only one that can grow in place */
+    char *last;
+    
+    /* the size of the shared blocks, allocations larger than a quarter of it get their own block */
+    size_t block_size;
+}arena;
+
+void arena_init (arena *, size_t);
+
+arena_block *arena_new_block (arena *, size_t, int);
+
+arena_block *arena_find_block (arena *, void *);
+
+void *arena_alloc (arena *, size_t);
+
+void *arena_calloc (arena *, size_t);
+
+void *arena_grow (arena *, void *, size_t, size_t);
+
+void arena_release (arena *, void *);
+
+void arena_free (arena *);
+
+#endif
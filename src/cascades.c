@@ -13,110 +13,123 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+
 #include "cascades.h"
 
-/* A function to check whether metabolites are only consumed */
-/* Also, null reactions are removed from the system */
-int check_cascades (metabolite *metabs, int Nmet, double ***s_zeros, int n_zeros, double *s, FILE *outfile){
+/* A function to set to zero all the inputs of metabolite i that are not null yet, and to append them to the worklist */
+void null_inputs (network *net, int i, char *is_null, int *queue, int *tail, cascade_report *report){
     
-    metabolite *dummy_m;
-    double **s_locked = *s_zeros, **dummy_s1, **dummy_s2;
-    int n_zeros_new=0;
+    int k, n_new = 0;
     
-    for (dummy_s1 = s_locked; dummy_s1 < s_locked + n_zeros; dummy_s1++){
+    for (k = *(net -> row + i); k < *(net -> split + i); k++){
+        
+        if ( *(is_null + *(net -> col + k)) ) continue;
+        
+        *(is_null + *(net -> col + k)) = 1;
+        
+        *(queue + *tail) = *(net -> col + k);
         
-        fprintf(outfile, "Reaction %d is zero\n", (int)(*dummy_s1 - s) + 1);
+        *tail += 1;
+        
+        n_new++;
     }
     
-    /* loop over null reactions and remove them from the system */
-    for (dummy_s1 = s_locked; dummy_s1 < s_locked + n_zeros; dummy_s1++){
+    report -> n_forced += n_new;
+    
+    if ( n_new > 0 ) report -> n_dead++;
+}
+
+/* A function to check whether metabolites are only consumed: if so, the reactions that consume them are set to zero, */
+/* which may leave more metabolites only consumed; the whole cascade is followed with a worklist of null reactions */
+/* over the transpose of the network, so that each entry is visited a bounded number of times */
+/* the null reactions are removed from the system at the end, the new ones are appended to s_zeros and their final number is returned */
+int check_cascades (network *net, int **s_zeros, int n_zeros, cascade_report *report){
+    
+    int i, j, k, head, tail = 0, had_transpose = net -> t_start != NULL;
+    
+    int *queue = (int *) malloc ( (net -> Nreact > 0 ? net -> Nreact : 1) * sizeof (int) ), *dummy_s1;
+    
+    /* the inputs and the outputs of each metabolite, not yet visited by the worklist */
+    int *n_in = (int *) malloc ( (net -> Nmet > 0 ? net -> Nmet : 1) * sizeof (int) );
+    
+    int *n_out = (int *) malloc ( (net -> Nmet > 0 ? net -> Nmet : 1) * sizeof (int) );
+    
+    char *is_null = (char *) calloc (net -> Nreact, sizeof (char) );
+    
+    report -> n_forced = 0;
+    
+    report -> n_dead = 0;
+    
+    /* the null reactions given are the first ones to visit (each one once) */
+    for (dummy_s1 = *s_zeros; dummy_s1 < *s_zeros + n_zeros; dummy_s1++){
         
-        /* loop over metabolites to check whther they participate to null reaction dummy_s1 */
-        for (dummy_m = metabs; dummy_m < metabs + Nmet; dummy_m++){
-            
-            /* initalise pointer to dummy_m input reactions array */
-            dummy_s2 = dummy_m -> input.react;
-            
-            /* loop over input reactions for metabolite dummy_m to check whether dummy_s1 is present */
-            while ( dummy_s2 < dummy_m -> input.react + dummy_m -> input.n_react && *dummy_s2 != *dummy_s1) dummy_s2++;
-            
-            /* if while loop halted within the range dummy_m -> input.n_react, then dummy_s1 is present */
-            if ( (int) (dummy_s2 - dummy_m -> input.react ) < dummy_m -> input.n_react ) {
-                
-                fprintf(outfile, "Removing reaction %d from inputs of metabolite %d... \n", (int) (*dummy_s2 - s) + 1, (int) (dummy_m - metabs) + 1);
-                
-                /* remove reaction dummy_s1 from input reactions of metabolite dummy_m */
-                remove_reaction(dummy_m -> input.react, dummy_s2, dummy_m -> input.n_react, dummy_m -> input.coeff);
-                
-                /* reduce the number of reactions in which dummy_m appears as an input */
-                dummy_m -> input.n_react -= 1;
-            }
-            
-            /* initalise pointer to dummy_m output reactions array */
-            dummy_s2 = dummy_m -> output.react;
-            
-            /* loop over output reactions for metabolite dummy_m to check whether dummy_s1 is present */
-            while ( dummy_s2 < dummy_m -> output.react + dummy_m -> output.n_react && *dummy_s2 != *dummy_s1) dummy_s2++;
-            
-            /* if while loop halted within the range dummy_m -> output.n_react, then dummy_s1 is present */
-            if ( (int) (dummy_s2 - dummy_m -> output.react ) < dummy_m -> output.n_react ) {
-                
-                fprintf(outfile, "Removing reaction %d from outputs of metabolite %d... \n", (int) (*dummy_s2 - s) + 1, (int) (dummy_m - metabs) + 1);
-                
-                /* remove reaction dummy_s1 from output reactions of metabolite dummy_m */
-                remove_reaction(dummy_m -> output.react, dummy_s2, dummy_m -> output.n_react, dummy_m -> output.coeff);
-                
-                /* reduce the number of reactions in which dummy_m appears as an output */
-                dummy_m -> output.n_react -= 1;
-                
-            }
-            
-        }
+        if ( *(is_null + *dummy_s1) ) continue;
+        
+        *(is_null + *dummy_s1) = 1;
         
+        *(queue + tail) = *dummy_s1;
+        
+        tail++;
     }
     
-    /* loop over all metabolites and check whether they are only consumed */
-    for (dummy_m = metabs; dummy_m < metabs + Nmet; dummy_m++){
+    report -> n_given = tail;
+    
+    for (i = 0; i < net -> Nmet; i++){
         
-        /* check if metabolite is only consumed */
-        if ( dummy_m -> output.n_react == 0 && dummy_m -> input.n_react != 0){
-            /* if so, set to zero all reactions that consume it */
-            
-            fprintf(outfile, "Metabolite %d is now only consumed...\n", (int) (dummy_m - metabs) + 1);
+        *(n_in + i) = *(net -> split + i) - *(net -> row + i);
+        
+        *(n_out + i) = *(net -> row + i + 1) - *(net -> split + i);
+        
+        /* the metabolites that are only consumed from the start */
+        if ( *(n_out + i) == 0 && *(n_in + i) > 0 ) null_inputs (net, i, is_null, queue, &tail, report);
+    }
+    
+    /* the null reactions reach their metabolites through the transpose */
+    if ( had_transpose == 0 ) network_transpose (net);
+    
+    /* visit the null reactions, while the cascade appends new ones */
+    for (head = 0; head < tail; head++){
+        
+        j = *(queue + head);
+        
+        for (k = *(net -> t_start + j); k < *(net -> t_start + j + 1); k++){
             
-            /* realloc the array of locked reactions to add all reactions that consume metabolite dummy_m */
-            s_locked = (double **) realloc (s_locked, (n_zeros + n_zeros_new + dummy_m -> input.n_react) * sizeof (double *) );
+            i = *(net -> t_row + k);
             
-            /* initialise the pointer to the old last element of s_locked */
-            dummy_s1 = s_locked + n_zeros + n_zeros_new;
+            /* inputs have negative coefficients */
+            if ( *(net -> t_coeff + k) < 0. ) *(n_in + i) -= 1;
             
-            /* loop over reactions that consume metabolite dummy_m */
-            for (dummy_s2 = dummy_m -> input.react; dummy_s2 < dummy_m -> input.react + dummy_m -> input.n_react; dummy_s2++){
+            else{
                 
-                fprintf(outfile, "Setting reaction %d to zero.....\n", (int) (*dummy_s2 - s) + 1);
-                
-                /* add reaction to s_locked */
-                *dummy_s1 = *dummy_s2;
-                
-                /* iterate over s_locked */
-                dummy_s1++;
+                *(n_out + i) -= 1;
                 
+                /* the metabolite has just lost its last output: if it is still consumed, its inputs are set to zero */
+                if ( *(n_out + i) == 0 && *(n_in + i) > 0 ) null_inputs (net, i, is_null, queue, &tail, report);
             }
-            
-            /* the number of null reactions is increased */
-            n_zeros_new += dummy_m -> input.n_react;
-            
         }
     }
     
+    /* leave the transpose as it was */
+    if ( had_transpose == 0 ) network_free_transpose (net);
+    
+    /* remove all the null reactions from the system in a single sweep over the network */
+    report -> n_removed = remove_reactions (net, is_null);
+    
+    /* append the reactions forced to zero to the given ones, with a single realloc */
+    if ( report -> n_forced > 0 ){
+        
+        *s_zeros = (int *) realloc (*s_zeros, (n_zeros + report -> n_forced) * sizeof (int) );
+        
+        memcpy (*s_zeros + n_zeros, queue + report -> n_given, report -> n_forced * sizeof (int) );
+    }
     
+    free (queue);
     
-    fprintf(outfile, "\n\n");
+    free (n_in);
     
-    /* if new reactions are set to zero, check recursively feasibility of the system */
-    if ( n_zeros_new > 0 )  return check_cascades (metabs, Nmet, s_zeros, n_zeros + n_zeros_new, s, outfile);
+    free (n_out);
     
-    /* otherwise return the final number of null reactions */
-    else return n_zeros;
+    free (is_null);
     
+    return n_zeros + report -> n_forced;
 }
@@ -19,10 +19,28 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 
 #include "metabolites.h"
 #include "remove_r.h"
 
-int check_cascades (metabolite *, int, double ***, int, double *, FILE *);
+/* what check_cascades did, reported at once instead of a log line per removal */
+typedef struct{
+    
+    /* the reactions given as null, and those forced to zero by the cascade */
+    int n_given;
+    
+    int n_forced;
+    
+    /* the metabolites left only consumed, which forced their inputs to zero */
+    int n_dead;
+    
+    /* the stoichiometric entries removed from the network */
+    int n_removed;
+}cascade_report;
+
+void null_inputs (network *, int, char *, int *, int *, cascade_report *);
+
+int check_cascades (network *, int **, int, cascade_report *);
 
 #endif
@@ -0,0 +1,454 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "constraints.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* the vectorised kernels are only built for x86 compilers that can target single functions */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VN_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+/* the kernels in use, selected once by constraints_init according to the features of the CPU */
+/* (before any parallel region: they are only read afterwards; until then the generic kernels are used) */
+static void (*values_kernel) (const network *, double *, double, double, double *, double *, int, int) = NULL;
+
+static int (*argmin_kernel) (double *, int, double *) = NULL;
+
+static const char *kernel_name = "generic";
+
+/* A function to compute the constraints of the metabolites first, ..., last - 1: */
+/* c[i] = scale * (s (a - rho b))_i + c_locked[i], the constant term being optional (NULL) */
+void constraint_values_generic (const network *net, double *s, double rho, double scale, double *c_locked, double *c, int first, int last){
+    
+    int i, k;
+    double c_in, c_out;
+    
+    for (i = first; i < last; i++){
+        
+        c_in = 0.;
+        
+        c_out = 0.;
+        
+        /* inputs: negative coefficients, weighted by rho */
+        for (k = *(net -> row + i); k < *(net -> split + i); k++) c_in += *(net -> coeff + k) * s[*(net -> col + k)];
+        
+        /* outputs */
+        for (k = *(net -> split + i); k < *(net -> row + i + 1); k++) c_out += *(net -> coeff + k) * s[*(net -> col + k)];
+        
+        *(c + i) = scale * (rho * c_in + c_out) + ( c_locked != NULL ? *(c_locked + i) : 0. );
+    }
+}
+
+/* A function to find the minimum of n values (the first one, if repeated) */
+int constraint_argmin_generic (double *c, int n, double *cmin){
+    
+    int i, which = 0;
+    
+    for (i = 1; i < n; i++) if ( *(c + i) < *(c + which) ) which = i;
+    
+    *cmin = n > 0 ? *(c + which) : 0.;
+    
+    return which;
+}
+
+#ifdef VN_X86_KERNELS
+
+/* A function to compute the constraint of a row, two entries at a time (SSE2 has no gather): */
+/* the entries before split are inputs, weighted by rho */
+static double __attribute__ ((target ("sse2"))) row_sum_sse2 (double *coeff, int32_t *col, double *s, double rho, int k, int split, int end){
+    
+    __m128d acc = _mm_setzero_pd();
+    double out[2];
+    
+    for (; k + 2 <= end; k += 2){
+        
+        /* the weights of the two entries: rho for the inputs, 1 for the outputs */
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_mul_pd(_mm_set_pd(k + 1 < split ? rho : 1., k < split ? rho : 1.), _mm_loadu_pd(coeff + k)),
+                                         _mm_set_pd(s[col[k + 1]], s[col[k]])));
+    }
+    
+    _mm_storeu_pd(out, acc);
+    
+    /* the remaining entry */
+    if ( k < end ) out[0] += ( k < split ? rho : 1. ) * coeff[k] * s[col[k]];
+    
+    return out[0] + out[1];
+}
+
+static void __attribute__ ((target ("sse2"))) constraint_values_sse2 (const network *net, double *s, double rho, double scale, double *c_locked, double *c, int first, int last){
+    
+    int i;
+    
+    for (i = first; i < last; i++){
+        
+        *(c + i) = scale * row_sum_sse2 (net -> coeff, net -> col, s, rho, *(net -> row + i), *(net -> split + i), *(net -> row + i + 1) )
+                   + ( c_locked != NULL ? *(c_locked + i) : 0. );
+    }
+}
+
+/* A function to find the (first) minimum of n values, two at a time (SSE2 has no blend: masks select instead) */
+static int __attribute__ ((target ("sse2"))) constraint_argmin_sse2 (double *c, int n, double *cmin){
+    
+    __m128d best, v, lt;
+    __m128i best_i, idx, step = _mm_set1_epi64x(2), m;
+    double lane_v[2];
+    long long lane_i[2];
+    int i, which;
+    
+    if ( n < 4 ) return constraint_argmin_generic (c, n, cmin);
+    
+    best = _mm_loadu_pd(c);
+    
+    best_i = _mm_set_epi64x(1, 0);
+    
+    idx = best_i;
+    
+    for (i = 2; i + 2 <= n; i += 2){
+        
+        idx = _mm_add_epi64(idx, step);
+        
+        v = _mm_loadu_pd(c + i);
+        
+        /* strictly smaller values only, so that each lane keeps its first minimum */
+        lt = _mm_cmplt_pd(v, best);
+        
+        m = _mm_castpd_si128(lt);
+        
+        best = _mm_or_pd(_mm_and_pd(lt, v), _mm_andnot_pd(lt, best));
+        
+        best_i = _mm_or_si128(_mm_and_si128(m, idx), _mm_andnot_si128(m, best_i));
+    }
+    
+    _mm_storeu_pd(lane_v, best);
+    
+    _mm_storeu_si128((__m128i *) lane_i, best_i);
+    
+    /* reduce the lanes, the lowest index winning ties */
+    which = (int) lane_i[0];
+    
+    if ( lane_v[1] < *(c + which) || ( lane_v[1] == *(c + which) && lane_i[1] < which ) ) which = (int) lane_i[1];
+    
+    /* the remaining values */
+    for (; i < n; i++) if ( *(c + i) < *(c + which) ) which = i;
+    
+    *cmin = *(c + which);
+    
+    return which;
+}
+
+/* A function to compute the constraint of a row, gathering four fluxes at a time: */
+/* the entries before split are inputs, weighted by rho */
+static double __attribute__ ((target ("avx2,fma"))) row_sum_avx2 (double *coeff, int32_t *col, double *s, double rho, int k, int split, int end){
+    
+    __m256d acc = _mm256_setzero_pd(), w;
+    __m256i lane = _mm256_set_epi64x(3, 2, 1, 0), vsplit = _mm256_set1_epi64x(split);
+    __m128d half;
+    double sum;
+    
+    for (; k + 4 <= end; k += 4){
+        
+        /* the weights of the four entries: rho for the inputs, 1 for the outputs */
+        w = _mm256_blendv_pd(_mm256_set1_pd(1.), _mm256_set1_pd(rho), _mm256_castsi256_pd(_mm256_cmpgt_epi64(vsplit, _mm256_add_epi64(lane, _mm256_set1_epi64x(k)))));
+        
+        acc = _mm256_fmadd_pd(_mm256_mul_pd(w, _mm256_loadu_pd(coeff + k)), _mm256_i32gather_pd(s, _mm_loadu_si128((__m128i *)(col + k)), 8), acc);
+    }
+    
+    /* reduce the four lanes */
+    half = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    
+    sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    
+    /* the remaining entries */
+    for (; k < end; k++) sum += ( k < split ? rho : 1. ) * coeff[k] * s[col[k]];
+    
+    return sum;
+}
+
+static void __attribute__ ((target ("avx2,fma"))) constraint_values_avx2 (const network *net, double *s, double rho, double scale, double *c_locked, double *c, int first, int last){
+    
+    int i;
+    
+    for (i = first; i < last; i++){
+        
+        *(c + i) = scale * row_sum_avx2 (net -> coeff, net -> col, s, rho, *(net -> row + i), *(net -> split + i), *(net -> row + i + 1) )
+                   + ( c_locked != NULL ? *(c_locked + i) : 0. );
+    }
+}
+
+/* A function to find the (first) minimum of n values, four at a time */
+static int __attribute__ ((target ("avx2"))) constraint_argmin_avx2 (double *c, int n, double *cmin){
+    
+    __m256d best, v, lt;
+    __m256i best_i, idx, step = _mm256_set1_epi64x(4);
+    double lane_v[4];
+    long long lane_i[4];
+    int i, l, which;
+    
+    if ( n < 8 ) return constraint_argmin_generic (c, n, cmin);
+    
+    best = _mm256_loadu_pd(c);
+    
+    best_i = _mm256_set_epi64x(3, 2, 1, 0);
+    
+    idx = best_i;
+    
+    for (i = 4; i + 4 <= n; i += 4){
+        
+        idx = _mm256_add_epi64(idx, step);
+        
+        v = _mm256_loadu_pd(c + i);
+        
+        /* strictly smaller values only, so that each lane keeps its first minimum */
+        lt = _mm256_cmp_pd(v, best, _CMP_LT_OQ);
+        
+        best = _mm256_blendv_pd(best, v, lt);
+        
+        best_i = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(best_i), _mm256_castsi256_pd(idx), lt));
+    }
+    
+    _mm256_storeu_pd(lane_v, best);
+    
+    _mm256_storeu_si256((__m256i *) lane_i, best_i);
+    
+    /* reduce the lanes, the lowest index winning ties */
+    which = (int) lane_i[0];
+    
+    for (l = 1; l < 4; l++) if ( lane_v[l] < *(c + which) || ( lane_v[l] == *(c + which) && lane_i[l] < which ) ) which = (int) lane_i[l];
+    
+    /* the remaining values */
+    for (; i < n; i++) if ( *(c + i) < *(c + which) ) which = i;
+    
+    *cmin = *(c + which);
+    
+    return which;
+}
+
+/* A function to compute the constraint of a row, gathering eight fluxes at a time (the tail is masked): */
+/* the entries before split are inputs, weighted by rho */
+static double __attribute__ ((target ("avx512f,avx512vl"))) row_sum_avx512 (double *coeff, int32_t *col, double *s, double rho, int k, int split, int end){
+    
+    __m512d acc = _mm512_setzero_pd(), w;
+    __m256i lane = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    __mmask8 m;
+    
+    for (; k < end; k += 8){
+        
+        /* the entries of the row among the next eight */
+        m = end - k >= 8 ? (__mmask8) 0xff : (__mmask8) ((1u << (end - k)) - 1u);
+        
+        /* the weights: rho for the inputs, 1 for the outputs */
+        w = _mm512_mask_blend_pd(_mm256_cmpgt_epi32_mask(_mm256_set1_epi32(split - k), lane), _mm512_set1_pd(1.), _mm512_set1_pd(rho));
+        
+        acc = _mm512_fmadd_pd(_mm512_mul_pd(w, _mm512_maskz_loadu_pd(m, coeff + k)), _mm512_mask_i32gather_pd(_mm512_setzero_pd(), m, _mm256_maskz_loadu_epi32(m, col + k), s, 8), acc);
+    }
+    
+    return _mm512_reduce_add_pd(acc);
+}
+
+static void __attribute__ ((target ("avx512f,avx512vl"))) constraint_values_avx512 (const network *net, double *s, double rho, double scale, double *c_locked, double *c, int first, int last){
+    
+    int i;
+    
+    for (i = first; i < last; i++){
+        
+        *(c + i) = scale * row_sum_avx512 (net -> coeff, net -> col, s, rho, *(net -> row + i), *(net -> split + i), *(net -> row + i + 1) )
+                   + ( c_locked != NULL ? *(c_locked + i) : 0. );
+    }
+}
+
+/* A function to find the (first) minimum of n values, eight at a time */
+static int __attribute__ ((target ("avx512f"))) constraint_argmin_avx512 (double *c, int n, double *cmin){
+    
+    __m512d best, v;
+    __m512i best_i, idx, step = _mm512_set1_epi64(8);
+    __mmask8 lt;
+    double lane_v[8];
+    long long lane_i[8];
+    int i, l, which;
+    
+    if ( n < 16 ) return constraint_argmin_generic (c, n, cmin);
+    
+    best = _mm512_loadu_pd(c);
+    
+    best_i = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    
+    idx = best_i;
+    
+    for (i = 8; i + 8 <= n; i += 8){
+        
+        idx = _mm512_add_epi64(idx, step);
+        
+        v = _mm512_loadu_pd(c + i);
+        
+        /* strictly smaller values only, so that each lane keeps its first minimum */
+        lt = _mm512_cmp_pd_mask(v, best, _CMP_LT_OQ);
+        
+        best = _mm512_mask_blend_pd(lt, best, v);
+        
+        best_i = _mm512_mask_blend_epi64(lt, best_i, idx);
+    }
+    
+    _mm512_storeu_pd(lane_v, best);
+    
+    _mm512_storeu_si512(lane_i, best_i);
+    
+    /* reduce the lanes, the lowest index winning ties */
+    which = (int) lane_i[0];
+    
+    for (l = 1; l < 8; l++) if ( lane_v[l] < *(c + which) || ( lane_v[l] == *(c + which) && lane_i[l] < which ) ) which = (int) lane_i[l];
+    
+    /* the remaining values */
+    for (; i < n; i++) if ( *(c + i) < *(c + which) ) which = i;
+    
+    *cmin = *(c + which);
+    
+    return which;
+}
+
+#endif
+
+/* A function to pick the kernels for the CPU we are running on */
+/* it writes the kernels shared by all threads: call it once, before any parallel region (main does) */
+void constraints_init (void){
+    
+    values_kernel = constraint_values_generic;
+    
+    argmin_kernel = constraint_argmin_generic;
+    
+    kernel_name = "generic";
+    
+#ifdef VN_X86_KERNELS
+    __builtin_cpu_init ();
+    
+    if ( __builtin_cpu_supports ("sse2") ){
+        
+        values_kernel = constraint_values_sse2;
+        
+        argmin_kernel = constraint_argmin_sse2;
+        
+        kernel_name = "sse2";
+    }
+    
+    if ( __builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma") ){
+        
+        values_kernel = constraint_values_avx2;
+        
+        argmin_kernel = constraint_argmin_avx2;
+        
+        kernel_name = "avx2";
+    }
+    
+    if ( __builtin_cpu_supports ("avx512f") && __builtin_cpu_supports ("avx512vl") ){
+        
+        values_kernel = constraint_values_avx512;
+        
+        argmin_kernel = constraint_argmin_avx512;
+        
+        kernel_name = "avx512";
+    }
+#endif
+}
+
+/* A function to compute the constraints of all metabolites with the fastest kernel available */
+void constraint_values (const network *net, double *s, double rho, double scale, double *c_locked, double *c){
+    
+    ( values_kernel != NULL ? values_kernel : constraint_values_generic ) (net, s, rho, scale, c_locked, c, 0, net -> Nmet);
+}
+
+/* A function to find the most violated constraint with the fastest kernel available */
+int constraint_argmin (double *c, int n, double *cmin){
+    
+    return ( argmin_kernel != NULL ? argmin_kernel : constraint_argmin_generic ) (c, n, cmin);
+}
+
+/* A function to compute the constraints of all metabolites and to find the most violated one (the first, if repeated): */
+/* the rows are split in n_threads contiguous blocks, whose minima are compared in order, so the result does not depend on n_threads */
+int constraint_scan (const network *net, double *s, double rho, double scale, double *c_locked, double *c, int n_threads, double *cmin){
+    
+    int which = -1;
+    
+    /* the kernels, read once (the generic ones if constraints_init was not called) */
+    void (*values) (const network *, double *, double, double, double *, double *, int, int) = values_kernel != NULL ? values_kernel : constraint_values_generic;
+    
+    int (*argmin) (double *, int, double *) = argmin_kernel != NULL ? argmin_kernel : constraint_argmin_generic;
+    
+#ifdef _OPENMP
+    if ( n_threads > 1 && net -> Nmet >= n_threads ){
+        
+        int t, *block_i;
+        
+        double *block_c;
+        
+        /* the minimum of each block, -1 if the block was not scanned */
+        block_i = (int *) malloc( n_threads * sizeof (int) );
+        
+        block_c = (double *) malloc( n_threads * sizeof (double) );
+        
+        for (t = 0; t < n_threads; t++) *(block_i + t) = -1;
+        
+#pragma omp parallel num_threads(n_threads)
+        {
+            int id = omp_get_thread_num (), n_team = omp_get_num_threads ();
+            
+            int first = (int) ( (long) net -> Nmet * id / n_team ), last = (int) ( (long) net -> Nmet * (id + 1) / n_team );
+            
+            if ( last > first ){
+                
+                values (net, s, rho, scale, c_locked, c, first, last);
+                
+                *(block_i + id) = first + argmin (c + first, last - first, block_c + id);
+            }
+        }
+        
+        /* the blocks are in row order: a later block wins only if strictly smaller */
+        for (t = 0; t < n_threads; t++){
+            
+            if ( *(block_i + t) >= 0 && ( which < 0 || *(block_c + t) < *cmin ) ){
+                
+                which = *(block_i + t);
+                
+                *cmin = *(block_c + t);
+            }
+        }
+        
+        free (block_i);
+        
+        free (block_c);
+        
+        return which;
+    }
+#else
+    /* without OpenMP the scan is serial */
+    (void) n_threads;
+#endif
+    
+    values (net, s, rho, scale, c_locked, c, 0, net -> Nmet);
+    
+    which = argmin (c, net -> Nmet, cmin);
+    
+    return which;
+}
+
+/* A function to get the name of the kernels in use */
+const char *constraint_kernel_name (void){
+    
+    return kernel_name;
+}
@@ -0,0 +1,39 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef __CONSTRAINTS_H__
+#define __CONSTRAINTS_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "metabolites.h"
+
+void constraints_init (void);
+
+void constraint_values (const network *, double *, double, double, double *, double *);
+
+int constraint_argmin (double *, int, double *);
+
+int constraint_scan (const network *, double *, double, double, double *, double *, int, double *);
+
+const char *constraint_kernel_name (void);
+
+void constraint_values_generic (const network *, double *, double, double, double *, double *, int, int);
+
+int constraint_argmin_generic (double *, int, double *);
+
+#endif
@@ -0,0 +1,125 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "continuation.h"
+
+/* A function to allocate a path keeping the last n_points accepted fluxes (at most FLUX_PATH_MAX) */
+void flux_path_alloc (flux_path *path, int n_points, int Nmet, int Nreact){
+    
+    int i;
+    
+    if ( n_points > FLUX_PATH_MAX ) n_points = FLUX_PATH_MAX;
+    
+    path -> n_points = n_points;
+    
+    path -> n = 0;
+    
+    path -> Nreact = Nreact;
+    
+    for (i = 0; i < n_points; i++) path -> s[i] = (double *) malloc( Nreact * sizeof (double) );
+    
+    path -> trial = (double *) malloc( Nreact * sizeof (double) );
+    
+    path -> c = (double *) malloc( Nmet * sizeof (double) );
+}
+
+/* A function to add the fluxes accepted at rho, dropping the oldest ones */
+void flux_path_push (flux_path *path, double rho, double *s){
+    
+    int i;
+    double *oldest;
+    
+    if ( path -> n_points < 1 ) return;
+    
+    /* recycle the array of the oldest point */
+    oldest = path -> s[path -> n_points - 1];
+    
+    for (i = path -> n_points - 1; i > 0; i--){
+        
+        path -> s[i] = path -> s[i - 1];
+        
+        path -> rho[i] = path -> rho[i - 1];
+    }
+    
+    path -> s[0] = oldest;
+    
+    path -> rho[0] = rho;
+    
+    memcpy (path -> s[0], s, path -> Nreact * sizeof (double) );
+    
+    if ( path -> n < path -> n_points ) path -> n++;
+}
+
+/* A function to get the sum of the violated constraints (a negative number, or zero) of the fluxes s at rho */
+double total_violation (const network *net, double *s, double rho, double *c){
+    
+    double v = 0., *dummy;
+    
+    constraint_values (net, s, rho, 1., NULL, c);
+    
+    for (dummy = c; dummy < c + net -> Nmet; dummy++) if ( *dummy < 0. ) v += *dummy;
+    
+    return v;
+}
+
+/* A function to predict the fluxes at rho, extrapolating the polynomial through the accepted points */
+/* negative fluxes are clipped and the prediction is normalised; it replaces s only if it violates the constraints less */
+/* returns 1 if s was replaced */
+int flux_path_predict (flux_path *path, const network *net, double rho, double *s, int *locked, int n_locked, double *lock_value){
+    
+    int i, l, j;
+    double w[FLUX_PATH_MAX], *trial = path -> trial;
+    
+    if ( path -> n < 2 ) return 0;
+    
+    /* the Lagrange weights of the points at rho */
+    for (i = 0; i < path -> n; i++){
+        
+        w[i] = 1.;
+        
+        for (l = 0; l < path -> n; l++) if ( l != i ) w[i] *= (rho - path -> rho[l]) / (path -> rho[i] - path -> rho[l]);
+    }
+    
+    for (j = 0; j < path -> Nreact; j++){
+        
+        trial[j] = 0.;
+        
+        for (i = 0; i < path -> n; i++) trial[j] += w[i] * path -> s[i][j];
+        
+        /* fluxes cannot be negative */
+        if ( trial[j] < 0. ) trial[j] = 0.;
+    }
+    
+    normalise_fluxes (trial, path -> Nreact, locked, n_locked, lock_value);
+    
+    /* the extrapolation amplifies the noise of the accepted fluxes: keep it only if it is closer to feasibility */
+    if ( total_violation (net, trial, rho, path -> c) <= total_violation (net, s, rho, path -> c) ) return 0;
+    
+    memcpy (s, trial, path -> Nreact * sizeof (double) );
+    
+    return 1;
+}
+
+/* A function to free the path */
+void flux_path_free (flux_path *path){
+    
+    int i;
+    
+    for (i = 0; i < path -> n_points; i++) free (path -> s[i]);
+    
+    free (path -> trial);
+    
+    free (path -> c);
+}
@@ -0,0 +1,59 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __CONTINUATION_H__
+#define __CONTINUATION_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "metabolites.h"
+#include "fluxes.h"
+#include "constraints.h"
+
+/* the maximum number of accepted points the prediction is extrapolated from */
+#define FLUX_PATH_MAX 3
+
+/* the last accepted (rho, s) pairs of a solve, the most recent first */
+typedef struct{
+    
+    int n_points;
+    
+    int n;
+    
+    int Nreact;
+    
+    double rho[FLUX_PATH_MAX];
+    
+    double *s[FLUX_PATH_MAX];
+    
+    /* the prediction and the constraints used to check it */
+    double *trial;
+    
+    double *c;
+}flux_path;
+
+void flux_path_alloc (flux_path *, int, int, int);
+
+void flux_path_push (flux_path *, double, double *);
+
+double total_violation (const network *, double *, double, double *);
+
+int flux_path_predict (flux_path *, const network *, double, double *, int *, int, double *);
+
+void flux_path_free (flux_path *);
+
+#endif
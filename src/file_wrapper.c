@@ -19,35 +19,205 @@
 #include "file_wrapper.h"
 
 void file_wrapper_free (file_wrapper **file_data){
+    
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+    
+    if ( (*file_data) -> map != NULL ) munmap( (void *) (*file_data) -> map, (*file_data) -> map_size);
+    
+#endif
+    
+    fclose( (*file_data) -> stream);
+    
+    free( (*file_data) -> buffer);
+    
+    free( *file_data);
+    
+    *file_data = NULL;
+}
 
-    free( (*file_data) -> file_content);
+/* A function to read one more piece of the input file into the buffer, return the number of chars read */
+/* the chars not yet read are moved to the front of the buffer first, and the buffer doubles if they fill it */
+long fill_input (file_wrapper *input_file){
+    
+    long kept;
+    size_t n_read;
+    
+    /* move the chars not yet read to the front of the buffer */
+    kept = (long) (input_file -> rest.end - input_file -> rest.begin);
+    
+    memmove (input_file -> buffer, input_file -> rest.begin, kept);
+    
+    /* if they fill the buffer, double it */
+    if ( kept == input_file -> buffer_allowed ){
+        
+        input_file -> buffer_allowed *= 2;
+        
+        input_file -> buffer = (char *) realloc (input_file -> buffer, input_file -> buffer_allowed * sizeof (char) );
+    }
+    
+    /* fill the rest of the buffer */
+    n_read = fread (input_file -> buffer + kept, sizeof (char), input_file -> buffer_allowed - kept, input_file -> stream);
+    
+    if ( n_read == 0 ) input_file -> eof = 1;
+    
+    input_file -> rest = span_of (input_file -> buffer, input_file -> buffer + kept + n_read);
+    
+    return (long) n_read;
+}
+
+/* A function to get the next line of the input file, return 0 when the file is over */
+/* the line is only valid until the next call */
+int next_input_line (file_wrapper *input_file, span *line){
+    
+    /* read more of the file until the buffer holds a whole line */
+    while ( !input_file -> eof && span_find (input_file -> rest, '\n') == NULL ) fill_input (input_file);
+    
+    return span_next_line ( &(input_file -> rest), line);
+}
 
-    if ( (*file_data) -> filetype == 2)
+/* A function to read the input file again from its beginning, return 0 if it cannot (e.g. a pipe) */
+int rewind_input (file_wrapper *input_file){
+    
+    /* a mapped file is all there already */
+    if ( input_file -> map != NULL ){
+        
+        input_file -> eof = 1;
         
-        parser_free ( &((*file_data) -> parser), (*file_data) -> Nmet );
+        input_file -> rest = span_of (input_file -> map, input_file -> map + input_file -> map_size);
+        
+        return 1;
+    }
+    
+    if ( fseek (input_file -> stream, 0, SEEK_SET) != 0 ) return 0;
+    
+    input_file -> eof = 0;
+    
+    input_file -> rest = span_of (input_file -> buffer, input_file -> buffer);
+    
+    return 1;
 }
 
-file_wrapper *handle_input_file (char *filename, int initial_n, FILE *log_file){
+/* A function to map the input file read only in memory, return 0 if it cannot be mapped */
+/* (e.g. a pipe, an empty file, or no mmap on the system), in which case it is read in chunks */
+int map_input (file_wrapper *input_file){
+    
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+    
+    struct stat file_stat;
+    void *map;
+    
+    /* only regular files with some content can be mapped */
+    if ( fstat (fileno (input_file -> stream), &file_stat) != 0 || !S_ISREG (file_stat.st_mode) || file_stat.st_size == 0 ) return 0;
+    
+    map = mmap (NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fileno (input_file -> stream), 0);
     
-    FILE *in_stream = fopen(filename, "rb");
+    if ( map == MAP_FAILED ) return 0;
     
-    long file_size = get_file_size (in_stream);
+#ifdef MADV_SEQUENTIAL
     
+    /* the file is read once from beginning to end: let the kernel read ahead */
+    madvise (map, file_stat.st_size, MADV_SEQUENTIAL);
+    
+#endif
+    
+    input_file -> map = (const char *) map;
+    
+    input_file -> map_size = (long) file_stat.st_size;
+    
+    return 1;
+    
+#else
+    
+    (void) input_file;
+    
+    return 0;
+    
+#endif
+}
+
+/* A function that guesses the type of the input file from the first data lines of its first buffer */
+/* the lines are only peeked at, so that a file that cannot be rewound (e.g. a pipe) can still be read once */
+/* a ">" means a reaction list, a varying number of columns an adjacency list, otherwise it is a matrix */
+/* a matrix guess is only tentative: the builder falls back to an adjacency list if a later line disagrees */
+int guess_file_type (file_wrapper *input_file){
+    
+    span probe, line;
+    int file_type = 1, n_lines = 0, n_columns0 = 0, max_react = -1;
+    
+    /* fill the first buffer, unless the file is mapped */
+    while ( !input_file -> eof && input_file -> rest.end - input_file -> rest.begin < input_file -> buffer_allowed ) fill_input (input_file);
+    
+    probe = input_file -> rest;
+    
+    /* for the first data lines, as long as they are whole */
+    while ( n_lines < PROBE_LINES && ( input_file -> eof || span_find (probe, '\n') != NULL ) && span_next_line (&probe, &line) ){
+        
+        /* only evaluate if not a comment */
+        if ( !is_data_line (line) ) continue;
+        
+        /* if the ">" sign in line, the file is a reaction list (i.e. featuring "-->")*/
+        if ( span_find (line, '>') != NULL ){
+            
+            file_type = 2;
+            
+            break;
+        }
+        
+        /* get the number of columns of the first line */
+        if ( n_lines == 0 ) n_columns0 = get_ncolumns (line, &max_react);
+        
+        /* if the number of columns varies, then it cannot be a matrix */
+        else if ( get_ncolumns (line, &max_react) != n_columns0 ) file_type = 0;
+        
+        n_lines++;
+    }
+    
+    return file_type;
+}
+
+/* A function to open the input file, map it in memory if possible, and guess its type */
+/* the network is then built reading the file once, by alloc_system */
+file_wrapper *handle_input_file (char *filename, int initial_n, FILE *log_file){
     
     file_wrapper *input_data = (file_wrapper*) malloc(1*sizeof(file_wrapper));
     
+    input_data -> stream = fopen(filename, "rb");
+    
+    if ( input_data -> stream == NULL ){
+        
+        fprintf(stderr, "Cannot open input file %s\n", filename);
+        
+        exit (EXIT_FAILURE);
+    }
+    
     input_data -> Nmet = 0;
     input_data -> Nreact = 0;
     
-    input_data -> parser = (metabolite_parse *) malloc( initial_n * sizeof( metabolite_parse ) );
+    input_data -> initial_n = initial_n;
     
-    input_data -> file_content = (char *) malloc ( file_size * (sizeof(char) ) );
+    input_data -> map = NULL;
     
-    fread(input_data -> file_content, sizeof(char), file_size, in_stream);
+    input_data -> map_size = 0;
     
-    fclose(in_stream);
+    input_data -> buffer = NULL;
     
-    input_data -> filetype = guess_file_type (input_data -> file_content, &(input_data -> parser), initial_n, &(input_data -> Nmet), &(input_data -> Nreact));
+    input_data -> buffer_allowed = 0;
+    
+    /* map the file if possible, otherwise get a buffer to read it in chunks */
+    if ( map_input (input_data) == 0 ){
+        
+        input_data -> buffer_allowed = INPUT_CHUNK;
+        
+        input_data -> buffer = (char *) malloc ( input_data -> buffer_allowed * sizeof(char) );
+        
+        input_data -> eof = 0;
+        
+        input_data -> rest = span_of (input_data -> buffer, input_data -> buffer);
+    }
+    
+    else rewind_input (input_data);
+    
+    input_data -> filetype = guess_file_type (input_data);
     
     
     fprintf(log_file, "Data from filetype %d\n", input_data -> filetype);
@@ -56,4 +226,3 @@ file_wrapper *handle_input_file (char *filename, int initial_n, FILE *log_file){
     return input_data;
     
 }
-
@@ -18,25 +18,69 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include "parse_file.h"
 
+/* the size of the chunks in which the input file is read */
+#define INPUT_CHUNK 1048576
+
+/* the number of data lines looked at to guess the type of the input file */
+#define PROBE_LINES 64
+
+/* the input file, read line by line */
+/* a regular file is mapped read only in memory, so that concurrent runs share its pages in the page cache */
+/* otherwise it is read through a buffer of a few chunks, which only keeps the lines not yet read */
 typedef struct{
     
     int filetype;
     
-    char *file_content;
+    /* the stream the file is read from */
+    FILE *stream;
+    
+    /* the mapped file and its size, NULL if the file is read in chunks */
+    const char *map;
+    
+    long map_size;
+    
+    /* the buffer, and the number of chars it can hold (NULL if the file is mapped) */
+    char *buffer;
+    
+    long buffer_allowed;
+    
+    /* the part of the buffer not yet read */
+    span rest;
     
+    /* 1 once the whole file has been read into the buffer */
+    int eof;
+    
+    /* the initial guess for the number of metabolites of a reaction list */
+    int initial_n;
+    
+    /* filled once the network has been built */
     int Nmet;
     
     int Nreact;
-    
-    metabolite_parse *parser;
 }file_wrapper;
 
+long fill_input (file_wrapper *);
+
+int next_input_line (file_wrapper *, span *);
+
+int rewind_input (file_wrapper *);
+
+int map_input (file_wrapper *);
+
+int guess_file_type (file_wrapper *);
+
 file_wrapper *handle_input_file (char *, int, FILE *);
 
 void file_wrapper_free (file_wrapper **);
     
 #endif
-
@@ -0,0 +1,43 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "flux_state.h"
+
+/* A function to allocate the state of a solve on Nreact reactions, n_locked of them locked */
+void flux_state_alloc (flux_state *fs, int Nreact, int n_locked, int *locked, double *lock_value){
+    
+    fs -> Nreact = Nreact;
+    
+    fs -> s = (double *) malloc ( Nreact * sizeof(double) );
+    
+    fs -> backup = (double *) malloc ( Nreact * sizeof(double) );
+    
+    fs -> n_locked = n_locked;
+    
+    fs -> locked = locked;
+    
+    fs -> lock_value = lock_value;
+    
+    /* a fixed stream, until the caller picks one */
+    rng_seed (&fs -> rng, 0);
+}
+
+/* A function to free the state of a solve (the locked reactions belong to the caller) */
+void flux_state_free (flux_state *fs){
+    
+    free (fs -> s);
+    
+    free (fs -> backup);
+}
@@ -0,0 +1,49 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __FLUX_STATE_H__
+#define __FLUX_STATE_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "rng.h"
+
+/* the state of a single solve: the network is shared (and only read) by all solves, this is not */
+typedef struct{
+    
+    int Nreact;
+    
+    /* the fluxes and the last successful ones */
+    double *s;
+    
+    double *backup;
+    
+    /* the locked reactions (indices) and their values: shared, not owned */
+    int n_locked;
+    
+    int *locked;
+    
+    double *lock_value;
+    
+    /* the random stream of the solve: the initial fluxes and the random sweep order (-p random) */
+    rng_state rng;
+}flux_state;
+
+void flux_state_alloc (flux_state *, int, int, int *, double *);
+
+void flux_state_free (flux_state *);
+
+#endif
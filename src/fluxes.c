@@ -50,15 +50,19 @@ void restore_backup ( double *s, double *s_backup, int Nreact){
 }
 
 /* Initialise the flux values. Fluxes are normalised so that their sum = N reactions */
-void initialise_fluxes (double *s, int Nreact, double **locked, int n_locked, double *lock_value){
+/* the random values are drawn from the generator rng of the solve */
+void initialise_fluxes (double *s, int Nreact, int *locked, int n_locked, double *lock_value, rng_state *rng){
     
-    double *dummy, **dummy_l, *lock_v, Z = 0., Z_l = 0.;
+    double *dummy, *lock_v, Z = 0., Z_l = 0.;
+    int *dummy_l;
+    
+    /* draw all gaussian random variables at once */
+    gauss_batch (rng, s, Nreact);
     
     for (dummy = s; dummy < s + Nreact; dummy++) {
         
         /* the initial values are absolute values of a gaussian random v.*/
-        /* *dummy = fabs( 1.e-6 + 1.e-4 * gaussdev() );*/
-        *dummy = fabs(  gaussdev() );
+        *dummy = fabs( *dummy );
         
         /* update normalisation coefficient */
         Z += *dummy;
@@ -81,7 +85,7 @@ void initialise_fluxes (double *s, int Nreact, double **locked, int n_locked, do
     for (dummy_l = locked; dummy_l < locked + n_locked; dummy_l++) {
         
         /* assign the right value */
-        **dummy_l = *lock_v;
+        s[*dummy_l] = *lock_v;
         
         
         lock_v++;
@@ -89,9 +93,10 @@ void initialise_fluxes (double *s, int Nreact, double **locked, int n_locked, do
 }
 
 /* A function to re-normalise fluxes after each MinOver run */
-void normalise_fluxes (double *s, int Nreact, double **locked, int n_locked, double *lock_value){
+void normalise_fluxes (double *s, int Nreact, int *locked, int n_locked, double *lock_value){
     
-    double *dummy, **dummy_l, Z = 0., Z_l = 0.;
+    double *dummy, Z = 0., Z_l = 0.;
+    int *dummy_l;
     
     /* compute the normalisation coefficient*/
     for (dummy = s; dummy < s + Nreact; dummy++) Z += *dummy;
@@ -99,9 +104,9 @@ void normalise_fluxes (double *s, int Nreact, double **locked, int n_locked, dou
     /* rest the locked values */
     for (dummy_l = locked; dummy_l < locked + n_locked; dummy_l++) {
         
-        Z -= **dummy_l;
+        Z -= s[*dummy_l];
         
-        Z_l += **dummy_l;
+        Z_l += s[*dummy_l];
     }
     
     for (dummy = s; dummy < s + Nreact; dummy++) {
@@ -119,7 +124,7 @@ void normalise_fluxes (double *s, int Nreact, double **locked, int n_locked, dou
     for (dummy_l = locked; dummy_l < locked + n_locked; dummy_l++) {
         
         /* assign the right value */
-        **dummy_l = *dummy;
+        s[*dummy_l] = *dummy;
         
         
         dummy++;
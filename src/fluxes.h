@@ -26,8 +26,8 @@ void backup_fluxes ( double *, double *, int);
 
 void restore_backup ( double *, double *, int);
 
-void initialise_fluxes (double *, int, double **, int, double *);
+void initialise_fluxes (double *, int, int *, int, double *, rng_state *);
 
-void normalise_fluxes (double *, int, double **, int, double *);
+void normalise_fluxes (double *, int, int *, int, double *);
 
 #endif
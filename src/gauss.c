@@ -15,30 +15,30 @@
 
 #include "gauss.h"
 
-/* A function to get a normally distributed variable */
-double gaussdev(){
+/* A function to fill g with n normally distributed variables from the generator r */
+/* the polar method gives two variables per accepted pair: both are used */
+void gauss_batch (rng_state *r, double *g, int n){
     
-    double   g1, g2, j, x1, x2, r_s;
+    double j, x1, x2, r_s, *dummy;
+    
+    for (dummy = g; dummy < g + n; dummy += 2){
         
         do {
             /* pick two random numbers from -1 to 1*/
-            x1 = 2.0 * drand48() - 1.0;
+            x1 = 2.0 * rng_uniform (r) - 1.0;
             
-            x2 = 2.0 * drand48() - 1.0;
+            x2 = 2.0 * rng_uniform (r) - 1.0;
             
             r_s = x1 * x1 + x2 * x2;
         }
         /* while they do not fall in the unit circle */
         while (r_s >= 1.0 || r_s == 0.0);
-
-         /* get two normally distributed variables */
-
+        
         j = sqrt(-2.0 * log(r_s) / r_s);
         
-        g1 = x1 * j;
-
-        g2 = x2 * j;
-    
-        return g1;
-    
+        *dummy = x1 * j;
+        
+        /* the second one, unless n is odd and this is the last */
+        if ( dummy + 1 < g + n ) *(dummy + 1) = x2 * j;
+    }
 }
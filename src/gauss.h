@@ -20,6 +20,8 @@
 #include <stdlib.h>
 #include <math.h>
 
-double gaussdev();
+#include "rng.h"
+
+void gauss_batch (rng_state *, double *, int);
 
 #endif
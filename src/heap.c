@@ -0,0 +1,123 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "heap.h"
+
+/* A function to compare two items: 1 if item a must stay above item b */
+static int heap_less (index_heap *h, int a, int b){
+    
+    return *(h -> key + a) < *(h -> key + b) || ( *(h -> key + a) == *(h -> key + b) && a < b );
+}
+
+/* A function to swap the heap positions p and q */
+static void heap_swap (index_heap *h, int p, int q){
+    
+    int tmp = *(h -> item + p);
+    
+    *(h -> item + p) = *(h -> item + q);
+    
+    *(h -> item + q) = tmp;
+    
+    /* keep the positions in sync */
+    *(h -> pos + *(h -> item + p)) = p;
+    
+    *(h -> pos + *(h -> item + q)) = q;
+}
+
+/* A function to move the item at position p up, while it is smaller than its parent */
+static void heap_sift_up (index_heap *h, int p){
+    
+    while ( p > 0 && heap_less (h, *(h -> item + p), *(h -> item + (p - 1) / 2) ) ){
+        
+        heap_swap (h, p, (p - 1) / 2);
+        
+        p = (p - 1) / 2;
+    }
+}
+
+/* A function to move the item at position p down, while it is larger than its smallest child */
+static void heap_sift_down (index_heap *h, int p){
+    
+    int child;
+    
+    while ( (child = 2 * p + 1) < h -> n ){
+        
+        /* pick the smallest child */
+        if ( child + 1 < h -> n && heap_less (h, *(h -> item + child + 1), *(h -> item + child) ) ) child++;
+        
+        /* stop if the heap order is restored */
+        if ( !heap_less (h, *(h -> item + child), *(h -> item + p) ) ) break;
+        
+        heap_swap (h, p, child);
+        
+        p = child;
+    }
+}
+
+/* A function to allocate an empty heap for up to n_items items, whose keys are stored in key */
+void heap_alloc (index_heap *h, int n_items, double *key){
+    
+    int *dummy;
+    
+    h -> n = 0;
+    
+    h -> item = (int *) malloc( n_items * sizeof (int) );
+    
+    h -> pos = (int *) malloc( n_items * sizeof (int) );
+    
+    h -> key = key;
+    
+    /* no item is in the heap yet */
+    for (dummy = h -> pos; dummy < h -> pos + n_items; dummy++) *dummy = -1;
+}
+
+/* A function to append an item without restoring the heap order (see heap_build) */
+void heap_push (index_heap *h, int which){
+    
+    *(h -> item + h -> n) = which;
+    
+    *(h -> pos + which) = h -> n;
+    
+    h -> n++;
+}
+
+/* A function to restore the heap order of all pushed items, in linear time */
+void heap_build (index_heap *h){
+    
+    int p;
+    
+    for (p = h -> n / 2 - 1; p >= 0; p--) heap_sift_down (h, p);
+}
+
+/* A function to restore the heap order after the key of an item has changed */
+void heap_update (index_heap *h, int which){
+    
+    int p = *(h -> pos + which);
+    
+    /* items that are not in the heap are ignored */
+    if ( p < 0 ) return;
+    
+    heap_sift_up (h, p);
+    
+    heap_sift_down (h, *(h -> pos + which) );
+}
+
+void heap_free (index_heap *h){
+    
+    free( h -> item);
+    
+    free( h -> pos);
+}
@@ -0,0 +1,50 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef __HEAP_H__
+#define __HEAP_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* an indexed binary min-heap over a set of items with external keys */
+/* ties are broken by item index, so that the minimum is the same a linear scan would find */
+typedef struct{
+    
+    /* number of items in the heap */
+    int n;
+    
+    /* the items, in heap order */
+    int *item;
+    
+    /* the position of each item in the heap (-1 if not in the heap) */
+    int *pos;
+    
+    /* the keys of the items, not owned by the heap */
+    double *key;
+}index_heap;
+
+void heap_alloc (index_heap *, int, double *);
+
+void heap_push (index_heap *, int);
+
+void heap_build (index_heap *);
+
+void heap_update (index_heap *, int);
+
+void heap_free (index_heap *);
+
+#endif
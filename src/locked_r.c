@@ -35,98 +35,41 @@ int get_n_locked (char *locked){
     
 }
 
-/* A function to fix the locked reactions by reading the optional argument -L */
-int fix_locked (int n_locked, double *s, double **s_locked, double *lock_v, char *locked){
+/* A function to fix the locked reactions by reading the optional argument -L, i.e. "index:value,index:value,..." */
+int fix_locked (int n_locked, int *s_locked, double *lock_v, char *locked){
     
-    char *l_index1 = locked, *l_index2, *l_index3, *copy1, *copy2;
+    span rest = span_of (locked, locked + strlen( locked ) ), pair;
     
-    int locked_string_length = strlen( locked ), which, n_zeros=0;
+    const char *colon;
     
-    double l_value, **dummy_s = s_locked;
+    int which, n_zeros=0, n_read = 0;
     
+    double l_value;
     
-    /* if there is only one locked reaction */
-    if ( n_locked == 1 ){
+    /* for each fixed reaction, separated by "," */
+    while ( n_read < n_locked && span_split (&rest, ',', &pair) ){
         
-        /* cut the string at ":" separating the index of reaction to lock from the value to assign */
-        l_index1 = strchr(locked, ':');
+        /* the ":" separates the index of reaction to lock from the value to assign */
+        colon = span_find (pair, ':');
         
-        /* copy the index bit of the string to a new string */
-        copy1 = get_substring (locked, l_index1);
+        if ( colon == NULL ) continue;
         
-        /* get the index from the substring */
-        which = atoll (copy1) - 1;
+        /* get the index of the reaction (counting from 1) */
+        which = (int) span_to_long (span_of (pair.begin, colon) ) - 1;
         
-        /* get the value to assign from the rest of the string */
-        l_value = atof (l_index1 + 1);
+        /* get the value to assign */
+        l_value = span_to_double (span_of (colon + 1, pair.end) );
         
         /* if value = 0 flag that there is a null reaction*/
         if (l_value == 0.) n_zeros += 1;
         
-        /* assign the pointer to the fixed reaction */
-        *dummy_s = s + which;
+        /* assign the index of the locked reaction */
+        *(s_locked + n_read) = which;
         
-        /* assign the value to the array of fixed values lock_v*/
-        *lock_v = l_value;
-        
-        /* free the substring */
-        free ( copy1 );
-        
-    }
-    
-    /* otherwise */
-    else if ( n_locked > 1 ){
-        
-        /* for each fixed reaction (found through the ":")*/
-        while ( (int) (l_index1 - locked) < locked_string_length + 1 && strchr(l_index1, ':') != NULL )  {
-            
-            /* find the substring containing the index of the reaction */
-            l_index2 = strchr(l_index1, ':');
-            
-            /* find the substring containing the value to assign */
-            l_index3 = strchr(l_index1, ',');
-            
-            /* if it is the last reaction there are no more "," - the value substring lasts till the end */
-            if ( l_index3 == NULL ) l_index3 = locked + locked_string_length;
-            
-            /* copy the index substring to a new string */
-            copy1 = get_substring (l_index1, l_index2);
-            
-            /* get the numerical index of the index */
-            which = atoi (copy1) - 1;
-            
-            /* copy the value substring to a new string */
-            copy2 = get_substring (l_index2 + 1 , l_index3);
-            
-            /* get the numerical value of the flux value */
-            l_value = atof (copy2);
-            
-            /* if value = 0 flag that there is a null reaction*/
-            if (l_value == 0.) n_zeros += 1;
-            
-            /* assign a pointer to the locked reaction */
-            *dummy_s = s + which;
-            
-            /* assign the value to the array */
-            *lock_v = l_value;
-            
-            /* free the first substring */
-            free ( copy1 );
-            
-            /* free the second substring */
-            free ( copy2 );
-            
-            /* get to next pointer to locked reactions */
-            dummy_s++;
-            
-            /* get to next array element of locked values*/
-            lock_v++;
-            
-            /* iterate over the whole string up to the next "," */
-            l_index1 = l_index3 + 1;
-            
-        }
+        /* assign the value to the array of fixed values lock_v */
+        *(lock_v + n_read) = l_value;
         
+        n_read++;
     }
     
     /* return the number of zero reactions*/
@@ -135,11 +78,12 @@ int fix_locked (int n_locked, double *s, double **s_locked, double *lock_v, char
     
 }
 
-/* A function to assign pointers to the null reactions (i.e. reactions locked to 0) */
+/* A function to list the null reactions (i.e. reactions locked to 0) */
 /* useful because these reactions can be removed from the system */
-double  **assign_null_reactions (double **s_locked, double *lock_v, int n_null, int n_locked){
+int *assign_null_reactions (int *s_locked, double *lock_v, int n_null, int n_locked){
     
-    double **s_null = (double **) malloc( n_null * sizeof (double *) ), **dummy_s, **dummy_s_null, *dummy_v;
+    int *s_null = (int *) malloc( n_null * sizeof (int) ), *dummy_s, *dummy_s_null;
+    double *dummy_v;
     
     dummy_s = s_locked;
     
@@ -151,34 +95,35 @@ double  **assign_null_reactions (double **s_locked, double *lock_v, int n_null,
         /* if a reaction is locked to 0 then */
         if ( *dummy_v == 0. ){
             
-            /* store the associated pointer into array s_null */
+            /* store the associated index into array s_null */
             *dummy_s_null = *dummy_s;
             
             /* iterate over the pointer to null reactions */
             dummy_s_null++;
         }
         
-        /* iterate over the pointer to locked reactions */
+        /* iterate over the locked reactions */
         dummy_s++;
     }
     
-    /* return the array of pointers to null reactions */
+    /* return the array of null reactions */
     return s_null;
 }
 
 /* A function to add reactions that may eventually be forced to zero to render the system solvable */
-int update_null_reactions (double **s_locked, double *lock_v, int n_null, int n_null_final, int n_locked, double **s_null) {
+int update_null_reactions (int *s_locked, double *lock_v, int n_null, int n_null_final, int n_locked, int *s_null) {
     
-    double **dummy_s, **dummy_s2, *dummy_v;
+    int *dummy_s, *dummy_s2;
+    double *dummy_v;
     
     dummy_s2 = s_locked + n_locked;
     
     dummy_v = lock_v + n_locked;
     
-    /* loop over the array of pointers to null reactions, from the last "known" value */
+    /* loop over the array of null reactions, from the last "known" value */
     for (dummy_s = s_null + n_null; dummy_s < s_null + n_null_final; dummy_s++){
         
-        /* assign the new pointer */
+        /* assign the new index */
         *dummy_s2 = *dummy_s;
         
         /* assign the zero value to the value array */
@@ -25,10 +25,10 @@
 
 int get_n_locked (char *);
 
-int fix_locked (int, double *, double **, double *, char *);
+int fix_locked (int, int *, double *, char *);
 
-double  **assign_null_reactions (double **, double *, int, int);
+int *assign_null_reactions (int *, double *, int, int);
 
-int update_null_reactions (double **, double *, int, int, int, double **);
+int update_null_reactions (int *, double *, int, int, int, int *);
 
 #endif
@@ -13,24 +13,259 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+
 #include "metabolites.h"
 
-void metabolite_free ( metabolite **met, int Nmet){
+/* A function to allocate the row structure of the network */
+/* entries are appended row by row, nnz_hint is only the initial guess for their number */
+/* Nmet may be 0 when the rows are not known in advance: they are then added as they come */
+/* all the arrays are taken from the arena of the network */
+void network_alloc (network *net, int Nmet, int Nreact, int nnz_hint){
+    
+    arena_init ( &(net -> mem), ARENA_BLOCK);
+    
+    net -> Nmet = Nmet;
+    
+    net -> Nmet_allowed = Nmet > 0 ? Nmet : 16;
+    
+    net -> Nreact = Nreact;
+    
+    net -> nnz = 0;
+    
+    /* always leave room for at least one entry, so that doubling works */
+    net -> nnz_allowed = nnz_hint > 0 ? nnz_hint : 1;
+    
+    /* one extra offset closes the last row */
+    net -> row = (int *) arena_alloc( &(net -> mem), (net -> Nmet_allowed + 1) * sizeof (int) );
+    
+    net -> split = (int *) arena_alloc( &(net -> mem), net -> Nmet_allowed * sizeof (int) );
+    
+    net -> col = (int32_t *) arena_alloc( &(net -> mem), net -> nnz_allowed * sizeof (int32_t) );
+    
+    net -> coeff = (double *) arena_alloc( &(net -> mem), net -> nnz_allowed * sizeof (double) );
+    
+    /* the first row starts at the beginning of the entry arrays */
+    *(net -> row) = 0;
+    
+    /* the transpose is only built on request */
+    net -> t_start = NULL;
+    
+    net -> t_row = NULL;
+    
+    net -> t_coeff = NULL;
+}
+
+/* A function to append a stoichiometric entry to the row currently being filled */
+void network_add_entry (network *net, int which, double coeff){
+    
+    /* if exceeding the number of allowed entries, realloc the arrays */
+    if ( net -> nnz >= net -> nnz_allowed ){
+        
+        /* double the number of allowed entries */
+        net -> nnz_allowed *= 2;
+        
+        /* realloc */
+        net -> col = (int32_t *) arena_grow ( &(net -> mem), net -> col, net -> nnz * sizeof (int32_t), net -> nnz_allowed * sizeof (int32_t) );
+        
+        net -> coeff = (double *) arena_grow ( &(net -> mem), net -> coeff, net -> nnz * sizeof (double), net -> nnz_allowed * sizeof (double) );
+    }
+    
+    /* store the reaction index and the signed coefficient */
+    *(net -> col + net -> nnz) = (int32_t) which;
+    
+    *(net -> coeff + net -> nnz) = coeff;
+    
+    net -> nnz++;
+}
 
-    metabolite *dummy;
+/* A function to flag that the inputs of row i are over and its outputs begin */
+void network_split_row (network *net, int i){
     
-    for (dummy = *met; dummy < (*met) + Nmet; dummy++) {
+    int old_allowed;
+    
+    /* if exceeding the number of allowed rows, realloc the row arrays */
+    if ( i >= net -> Nmet_allowed ){
+        
+        /* double the number of allowed rows */
+        old_allowed = net -> Nmet_allowed;
         
-        free( dummy -> input.react);
+        while ( i >= net -> Nmet_allowed ) net -> Nmet_allowed *= 2;
         
-        free( dummy -> input.coeff);
+        /* realloc */
+        net -> row = (int *) arena_grow ( &(net -> mem), net -> row, (old_allowed + 1) * sizeof (int), (net -> Nmet_allowed + 1) * sizeof (int) );
         
-        free( dummy -> output.react);
+        net -> split = (int *) arena_grow ( &(net -> mem), net -> split, old_allowed * sizeof (int), net -> Nmet_allowed * sizeof (int) );
+    }
+    
+    *(net -> split + i) = net -> nnz;
+}
+
+/* A function to close row i, so that the next entries belong to row i+1 */
+void network_end_row (network *net, int i){
+    
+    *(net -> row + i + 1) = net -> nnz;
+    
+    /* rows added as they come count as metabolites */
+    if ( i >= net -> Nmet ) net -> Nmet = i + 1;
+}
+
+/* A function to build the reaction-to-metabolite index, i.e. the network stored column-wise */
+void network_transpose (network *net){
+    
+    int i, k, *fill;
+    
+    /* drop a previous (possibly outdated) transpose */
+    network_free_transpose (net);
+    
+    net -> t_start = (int *) arena_calloc( &(net -> mem), (net -> Nreact + 1) * sizeof (int) );
+    
+    net -> t_row = (int32_t *) arena_alloc( &(net -> mem), (net -> nnz > 0 ? net -> nnz : 1) * sizeof (int32_t) );
+    
+    net -> t_coeff = (double *) arena_alloc( &(net -> mem), (net -> nnz > 0 ? net -> nnz : 1) * sizeof (double) );
+    
+    /* count the entries of each column */
+    for (k = 0; k < net -> nnz; k++) *(net -> t_start + *(net -> col + k) + 1) += 1;
+    
+    /* turn the counts into offsets */
+    for (k = 0; k < net -> Nreact; k++) *(net -> t_start + k + 1) += *(net -> t_start + k);
+    
+    /* the next free position of each column */
+    fill = (int *) malloc( (net -> Nreact > 0 ? net -> Nreact : 1) * sizeof (int) );
+    
+    for (k = 0; k < net -> Nreact; k++) *(fill + k) = *(net -> t_start + k);
+    
+    /* scatter the rows into the columns, rows come out sorted within each column */
+    for (i = 0; i < net -> Nmet; i++){
         
-        free( dummy -> output.coeff);
+        for (k = *(net -> row + i); k < *(net -> row + i + 1); k++){
+            
+            *(net -> t_row + *(fill + *(net -> col + k))) = i;
+            
+            *(net -> t_coeff + *(fill + *(net -> col + k))) = *(net -> coeff + k);
+            
+            *(fill + *(net -> col + k)) += 1;
+        }
     }
     
-    free(*met);
+    free (fill);
+}
+
+/* the transpose may be rebuilt many times: its large arrays are given back to the arena right away */
+void network_free_transpose (network *net){
+    
+    arena_release ( &(net -> mem), net -> t_start);
+    
+    arena_release ( &(net -> mem), net -> t_row);
+    
+    arena_release ( &(net -> mem), net -> t_coeff);
+    
+    net -> t_start = NULL;
+    
+    net -> t_row = NULL;
+    
+    net -> t_coeff = NULL;
+}
+
+/* A function to free all the arrays of the network at once, through its arena */
+void network_free (network *net){
+    
+    arena_free ( &(net -> mem) );
+    
+    net -> t_start = NULL;
+    
+    net -> t_row = NULL;
+    
+    net -> t_coeff = NULL;
     
     return;
 }
+
+/* A function to allocate an empty list of entries from an arena, n_hint is only the initial guess for their number */
+/* there is no function to free the list: it goes with the arena */
+void entry_list_alloc (entry_list *list, arena *mem, int n_hint){
+    
+    list -> n = 0;
+    
+    list -> n_allowed = n_hint > 0 ? n_hint : 1;
+    
+    list -> mem = mem;
+    
+    list -> row = (int32_t *) arena_alloc( mem, list -> n_allowed * sizeof (int32_t) );
+    
+    list -> col = (int32_t *) arena_alloc( mem, list -> n_allowed * sizeof (int32_t) );
+    
+    list -> coeff = (double *) arena_alloc( mem, list -> n_allowed * sizeof (double) );
+}
+
+/* A function to append the entry (row, col) to the list */
+void entry_list_add (entry_list *list, int row, int col, double coeff){
+    
+    /* if exceeding the number of allowed entries, realloc the arrays */
+    if ( list -> n >= list -> n_allowed ){
+        
+        /* double the number of allowed entries */
+        list -> n_allowed *= 2;
+        
+        /* realloc */
+        list -> row = (int32_t *) arena_grow (list -> mem, list -> row, list -> n * sizeof (int32_t), list -> n_allowed * sizeof (int32_t) );
+        
+        list -> col = (int32_t *) arena_grow (list -> mem, list -> col, list -> n * sizeof (int32_t), list -> n_allowed * sizeof (int32_t) );
+        
+        list -> coeff = (double *) arena_grow (list -> mem, list -> coeff, list -> n * sizeof (double), list -> n_allowed * sizeof (double) );
+    }
+    
+    *(list -> row + list -> n) = (int32_t) row;
+    
+    *(list -> col + list -> n) = (int32_t) col;
+    
+    *(list -> coeff + list -> n) = coeff;
+    
+    list -> n++;
+}
+
+/* A function to allocate the network of Nmet metabolites and Nreact reactions holding the entries of a list */
+/* within each row, inputs (negative coefficients) come first, and entries keep the order of the list */
+void network_from_entries (network *net, entry_list *list, int Nmet, int Nreact){
+    
+    int i, k, *fill_in, *fill_out;
+    
+    network_alloc (net, Nmet, Nreact, list -> n);
+    
+    /* count the inputs and the outputs of each row, in the arena of the list */
+    fill_in = (int *) arena_calloc( list -> mem, (Nmet + 1) * sizeof (int) );
+    
+    fill_out = (int *) arena_calloc( list -> mem, (Nmet + 1) * sizeof (int) );
+    
+    for (k = 0; k < list -> n; k++){
+        
+        if ( *(list -> coeff + k) < 0. ) *(fill_in + *(list -> row + k)) += 1;
+        
+        else *(fill_out + *(list -> row + k)) += 1;
+    }
+    
+    /* turn the counts into offsets, and keep the next free input and output position of each row */
+    for (i = 0; i < Nmet; i++){
+        
+        *(net -> split + i) = *(net -> row + i) + *(fill_in + i);
+        
+        *(net -> row + i + 1) = *(net -> split + i) + *(fill_out + i);
+        
+        *(fill_in + i) = *(net -> row + i);
+        
+        *(fill_out + i) = *(net -> split + i);
+    }
+    
+    /* scatter the entries into their rows */
+    for (k = 0; k < list -> n; k++){
+        
+        if ( *(list -> coeff + k) < 0. ) i = (*(fill_in + *(list -> row + k)))++;
+        
+        else i = (*(fill_out + *(list -> row + k)))++;
+        
+        *(net -> col + i) = *(list -> col + k);
+        
+        *(net -> coeff + i) = *(list -> coeff + k);
+    }
+    
+    net -> nnz = list -> n;
+}
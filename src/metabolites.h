@@ -18,30 +18,92 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
-/* a structure to store I/O metabolite/reactions adjacency lists*/
+#include "arena.h"
+
+/* the stoichiometry of the whole system, stored in compressed sparse row (CSR) form */
+/* each row is a metabolite: its input reactions come first, then its output reactions */
 typedef struct{
     
-    /* number of reactions attached */
-    int n_react;
+    /* number of metabolites (rows), and number of rows that can be stored before reallocating */
+    int Nmet;
+    
+    int Nmet_allowed;
+    
+    /* number of reactions (columns) */
+    int Nreact;
+    
+    /* number of stored stoichiometric entries */
+    int nnz;
+    
+    /* number of entries that can be stored before reallocating */
+    int nnz_allowed;
+    
+    /* row offsets: metabolite i spans the entries [row[i], row[i+1]) */
+    int *row;
+    
+    /* first output entry of each row: inputs span [row[i], split[i]), outputs [split[i], row[i+1]) */
+    int *split;
     
-    /* an array of pointers to the value of the reaction */
-    double **react;
+    /* the reaction (column) index of each entry */
+    int32_t *col;
     
-    /* an array of stoichiometric coefficients */
+    /* signed stoichiometric coefficients: negative for inputs, positive for outputs */
     double *coeff;
-}adjacency;
+    
+    /* the transpose of the matrix above (NULL until network_transpose is called): */
+    /* column offsets, reaction j spans the entries [t_start[j], t_start[j+1]) */
+    int *t_start;
+    
+    /* the metabolite (row) index of each transposed entry */
+    int32_t *t_row;
+    
+    /* the signed coefficient of each transposed entry */
+    double *t_coeff;
+    
+    /* the arena owning all the arrays above, freed at once by network_free */
+    arena mem;
+}network;
 
-/* a metabolite structure */
+/* a list of stoichiometric entries in any order (coordinate form), to be turned into a network at once */
 typedef struct{
     
-    /* input reactions*/
-    adjacency input;
+    /* number of stored entries, and number of entries that can be stored before reallocating */
+    int n;
+    
+    int n_allowed;
+    
+    /* the metabolite (row) and the reaction (column) of each entry */
+    int32_t *row;
     
-    /*output reactions*/
-    adjacency output;
-}metabolite;
+    int32_t *col;
+    
+    /* signed stoichiometric coefficients: negative for inputs, positive for outputs */
+    double *coeff;
+    
+    /* the arena the arrays are taken from: the list is freed with it */
+    arena *mem;
+}entry_list;
+
+void network_alloc (network *, int, int, int);
+
+void network_add_entry (network *, int, double);
+
+void network_split_row (network *, int);
+
+void network_end_row (network *, int);
+
+void network_transpose (network *);
+
+void network_free_transpose (network *);
+
+void network_free (network *);
+
+void entry_list_alloc (entry_list *, arena *, int);
+
+void entry_list_add (entry_list *, int, int, double);
 
-void metabolite_free ( metabolite **, int);
+void network_from_entries (network *, entry_list *, int, int);
 
 #endif
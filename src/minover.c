@@ -13,105 +13,781 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+
 #include "minover.h"
 
-/*run the minover algorithm for fixed rho value*/
-int minover (metabolite *metabs, double *s, double **locked, int n_locked, double *lock_value, double rho, int Nmet, int max_step, double eta, int Nreac){
+/* A function to compute the constraint of metabolite i, i.e. (s (a - rho b))_i */
+double row_constraint (const network *net, double *s, double rho, int i){
     
-    /* pointers to iterate over the metabolites*/
-    metabolite *dummy_m, *dummy0;
+    double c = 0., *coeff, *coeff_end;
+    int32_t *col;
     
-    double c, cmu0, **s_d, *coeff, check_sign;
+    /* walk the (input) entries of the row: coefficients are negative */
+    coeff = net -> coeff + *(net -> row + i);
     
-    int step=0;
+    coeff_end = net -> coeff + *(net -> split + i);
     
-    /* iterate the algorithm until all constraints are satisfied*/
-    do{
+    col = net -> col + *(net -> row + i);
+    
+    while (coeff < coeff_end) {
+        
+        c += *coeff * s[*col];
+        
+        coeff++;
+        
+        col++;
+    }
+    
+    /* inputs are weighted by rho */
+    c *= rho;
+    
+    /* walk the (output) entries of the row, up to the beginning of the next one */
+    coeff_end = net -> coeff + *(net -> row + i + 1);
+    
+    while (coeff < coeff_end) {
+        
+        c += *coeff * s[*col];
+        
+        coeff++;
+        
+        col++;
+    }
+    
+    return c;
+}
+
+/* A function to start working on lazily normalised fluxes */
+/* locked fluxes are set to zero and replaced by a constant term in the constraints they appear in */
+void lazy_begin (lazy_fluxes *lf, const network *net, double *s, int *locked, int n_locked, double *lock_value, double rho){
+    
+    double *v, *dummy;
+    int i, k, *dummy_i, *s_d;
+    
+    lf -> is_locked = (char *) calloc( net -> Nreact, sizeof (char) );
+    
+    lf -> c_locked = (double *) calloc( net -> Nmet, sizeof (double) );
+    
+    lf -> z_free = (double) net -> Nreact;
+    
+    /* the scratch space of the exact step holds one row */
+    for (i = 0, k = 0; i < net -> Nmet; i++) if ( *(net -> row + i + 1) - *(net -> row + i) > k ) k = *(net -> row + i + 1) - *(net -> row + i);
+    
+    lf -> bp_eta = (double *) malloc( (k > 0 ? k : 1) * sizeof (double) );
+    
+    lf -> bp_g2 = (double *) malloc( (k > 0 ? k : 1) * sizeof (double) );
+    
+    /* flag the locked reactions and rest their value from the target normalisation */
+    v = lock_value;
+    
+    for (s_d = locked; s_d < locked + n_locked; s_d++){
+        
+        *(lf -> is_locked + *s_d) = 1;
+        
+        lf -> z_free -= *v;
+        
+        v++;
+    }
+    
+    /* the constant contribution of the locked reactions to each constraint */
+    v = lock_value;
+    
+    for (s_d = locked; s_d < locked + n_locked; s_d++){
+        
+        s[*s_d] = *v;
         
+        v++;
+    }
+    
+    lf -> n_fixed = 0;
+    
+    for (i = 0; i < net -> Nmet; i++){
         
-        /*loop over metabolites*/
-        for (dummy_m = metabs; dummy_m < metabs + Nmet; dummy_m++){
+        for (k = *(net -> row + i); k < *(net -> row + i + 1); k++){
             
-            c=0;
+            if ( *(lf -> is_locked + *(net -> col + k)) ) *(lf -> c_locked + i) += *(net -> coeff + k) * ( k < *(net -> split + i) ? rho : 1. ) * s[*(net -> col + k)];
+        }
+        
+        if ( *(lf -> c_locked + i) != 0. ) lf -> n_fixed++;
+    }
+    
+    /* keep a list of the rows with a constant term */
+    lf -> fixed_rows = (int *) malloc( (lf -> n_fixed > 0 ? lf -> n_fixed : 1) * sizeof (int) );
+    
+    dummy_i = lf -> fixed_rows;
+    
+    for (i = 0; i < net -> Nmet; i++){
+        
+        if ( *(lf -> c_locked + i) != 0. ){
             
-            /* loop over (input) reactions attached to the metabolite dummy_m */
-            coeff = dummy_m -> input.coeff;
+            *dummy_i = i;
             
-            for (s_d = dummy_m -> input.react; s_d < dummy_m -> input.react + dummy_m -> input.n_react; s_d++){
-                
-                c -= **s_d * (*coeff) * rho;
-                
-                coeff++;
-            }
+            dummy_i++;
+        }
+    }
+    
+    /* the locked fluxes do not take part in the free ones */
+    for (s_d = locked; s_d < locked + n_locked; s_d++) s[*s_d] = 0.;
+    
+    /* compute the running sum of the free fluxes */
+    lf -> sum = 0.;
+    
+    for (dummy = s; dummy < s + net -> Nreact; dummy++) lf -> sum += *dummy;
+    
+    lf -> scale = lf -> z_free / lf -> sum;
+}
+
+/* A function to materialise the scale factor into the fluxes, also clearing the rounding errors of the running sum */
+void lazy_rebase (lazy_fluxes *lf, double *s, int Nreact){
+    
+    double *dummy;
+    
+    lf -> sum = 0.;
+    
+    for (dummy = s; dummy < s + Nreact; dummy++){
+        
+        *dummy *= lf -> scale;
+        
+        lf -> sum += *dummy;
+    }
+    
+    lf -> scale = lf -> z_free / lf -> sum;
+}
+
+/* A function to stop working on lazily normalised fluxes */
+/* the locked values are restored, the free fluxes are left unnormalised (see normalise_fluxes) */
+void lazy_end (lazy_fluxes *lf, double *s, int *locked, int n_locked, double *lock_value){
+    
+    double *v = lock_value;
+    int *s_d;
+    
+    for (s_d = locked; s_d < locked + n_locked; s_d++){
+        
+        s[*s_d] = *v;
+        
+        v++;
+    }
+    
+    free (lf -> is_locked);
+    
+    free (lf -> c_locked);
+    
+    free (lf -> fixed_rows);
+    
+    free (lf -> bp_eta);
+    
+    free (lf -> bp_g2);
+}
+
+/* A function to apply the minover update of metabolite i0 to the lazily normalised fluxes */
+/* if key is not NULL, the cached constraints (in units of the scale factor) and the heap h are updated too */
+void lazy_update_row (lazy_fluxes *lf, const network *net, double *s, double rho, double eta, int i0, double *key, index_heap *h){
+    
+    int k, t, j;
+    double old, delta, a, inv_scale = 1. / lf -> scale;
+    
+    for (k = *(net -> row + i0); k < *(net -> row + i0 + 1); k++){
+        
+        j = *(net -> col + k);
+        
+        /* locked reactions are not updated */
+        if ( *(lf -> is_locked + j) ) continue;
+        
+        old = s[j];
+        
+        /* update the flux according to minover rule, with the step expressed in unnormalised units */
+        /* inputs are weighted by rho and cannot become negative */
+        if ( k < *(net -> split + i0) ){
             
-            /* loop over (output) reactions attached to the metabolite dummy_m */
-            coeff = dummy_m -> output.coeff;
+            s[j] += *(net -> coeff + k) * rho * eta * inv_scale;
             
-            for (s_d = dummy_m -> output.react; s_d < dummy_m -> output.react + dummy_m -> output.n_react; s_d++){
+            if ( s[j] < 0. ) s[j] = 0.;
+        }
+        
+        else s[j] += *(net -> coeff + k) * eta * inv_scale;
+        
+        delta = s[j] - old;
+        
+        /* keep track of the normalisation */
+        lf -> sum += delta;
+        
+        if ( key == NULL || delta == 0. ) continue;
+        
+        /* update the cached constraints of all metabolites taking part in reaction j */
+        for (t = *(net -> t_start + j); t < *(net -> t_start + j + 1); t++){
+            
+            a = *(net -> t_coeff + t);
+            
+            *(key + *(net -> t_row + t)) += ( a < 0. ? a * rho : a ) * delta;
+            
+            heap_update (h, *(net -> t_row + t));
+        }
+    }
+    
+    /* the normalisation is only applied lazily, through the scale factor */
+    lf -> scale = lf -> z_free / lf -> sum;
+}
+
+/* A function to get the step that brings the constraint c0 of metabolite i0 exactly to zero */
+/* the minover update moves the normalised flux of each free entry by g * eta, g = coeff (times rho for inputs), */
+/* until inputs reach zero: the constraint is then a concave, piecewise linear function of eta, solved breakpoint by breakpoint */
+/* if no step can fix the constraint, the step clipping all inputs is returned */
+double exact_step (lazy_fluxes *lf, const network *net, double *s, double rho, double c0, int i0){
+    
+    int k, j, n_bp = 0, b;
+    double g, slope = 0., slope_out = 0., eta = 0., t, c = c0;
+    
+    for (k = *(net -> row + i0); k < *(net -> row + i0 + 1); k++){
+        
+        j = *(net -> col + k);
+        
+        if ( *(lf -> is_locked + j) ) continue;
+        
+        g = *(net -> coeff + k) * ( k < *(net -> split + i0) ? rho : 1. );
+        
+        slope += g * g;
+        
+        if ( k >= *(net -> split + i0) ) slope_out += g * g;
+        
+        /* inputs stop at zero: keep their breakpoints sorted (rows are short) */
+        if ( k < *(net -> split + i0) ){
+            
+            t = lf -> scale * s[j] / (-g);
+            
+            for (b = n_bp; b > 0 && *(lf -> bp_eta + b - 1) > t; b--){
                 
-                c += **s_d * (*coeff);
+                *(lf -> bp_eta + b) = *(lf -> bp_eta + b - 1);
                 
-                coeff++;
+                *(lf -> bp_g2 + b) = *(lf -> bp_g2 + b - 1);
             }
             
-            /* store the minimum constraint */
-            if( dummy_m == metabs || c < cmu0) {
+            *(lf -> bp_eta + b) = t;
+            
+            *(lf -> bp_g2 + b) = g * g;
+            
+            n_bp++;
+        }
+    }
+    
+    for (b = 0; b < n_bp; b++){
+        
+        /* the constraint reaches zero before the next input is clipped */
+        if ( slope > 0. && c + slope * (*(lf -> bp_eta + b) - eta) >= 0. ) return eta - c / slope;
+        
+        c += slope * (*(lf -> bp_eta + b) - eta);
+        
+        eta = *(lf -> bp_eta + b);
+        
+        slope -= *(lf -> bp_g2 + b);
+    }
+    
+    /* all inputs are clipped: only the outputs are left */
+    return slope_out > 0. ? eta - c / slope_out : eta;
+}
+
+/* A function to get the step of the minover update of metabolite i0, whose constraint is c0 */
+/* the fixed step eta, or the exact step times the relaxation factor */
+/* the exact step is never smaller than eta: otherwise constraints left at -1e-16 by rounding would only be approached, never fixed */
+double update_eta (lazy_fluxes *lf, const network *net, double *s, double rho, double eta, double c0, int i0, solver_options *opt){
+    
+    double step;
+    
+    if ( opt == NULL || opt -> update != VN_UPDATE_EXACT ) return eta;
+    
+    step = opt -> relaxation * exact_step (lf, net, s, rho, c0, i0);
+    
+    return step > eta ? step : eta;
+}
+
+/* A function to set up the watch on the worst violation, as given by the options */
+void stall_begin (stall_monitor *sm, solver_options *opt){
+    
+    sm -> window = opt != NULL ? opt -> stall_window : 0;
+    
+    sm -> patience = opt != NULL && opt -> stall_patience > 0 ? opt -> stall_patience : 1;
+    
+    sm -> count = 0;
+    
+    sm -> idle = 0;
+    
+    sm -> best = HUGE_VAL;
+    
+    sm -> window_best = HUGE_VAL;
+}
+
+/* A function to record the worst constraint c0 of a step: returns 1 if minover should give up */
+/* i.e. if the worst violation has not shrunk by 1% over the last patience windows */
+int stall_check (stall_monitor *sm, double c0){
+    
+    if ( sm -> window <= 0 || c0 >= 0 ) return 0;
+    
+    if ( -c0 < sm -> window_best ) sm -> window_best = -c0;
+    
+    if ( ++ sm -> count < sm -> window ) return 0;
+    
+    /* the window is over: compare its smallest violation with the best so far */
+    if ( sm -> window_best < 0.99 * sm -> best ) sm -> idle = 0;
+    
+    else sm -> idle++;
+    
+    if ( sm -> window_best < sm -> best ) sm -> best = sm -> window_best;
+    
+    sm -> count = 0;
+    
+    sm -> window_best = HUGE_VAL;
+    
+    return sm -> idle >= sm -> patience;
+}
+
+/*run the minover algorithm for fixed rho value*/
+/* the fluxes are normalised lazily: on exit they are correct up to a positive factor, that normalise_fluxes removes */
+/* returns the number of steps, or max_step if the constraints are still violated (also when the run is given up early) */
+int minover (const network *net, double *s, int *locked, int n_locked, double *lock_value, double rho, int max_step, double eta, solver_options *opt, rng_state *rng){
+    
+    /* the sweeping variants do not look for the most violated constraint */
+    if ( opt != NULL && opt -> selection != VN_SELECT_ARGMIN ) return minover_sweep (net, s, locked, n_locked, lock_value, rho, max_step, eta, opt, rng);
+    
+    /* the block variant fixes several constraints per scan, and keeps the momentum */
+    if ( opt != NULL && (opt -> block_size != 1 || opt -> momentum > 0.) ) return minover_block (net, s, locked, n_locked, lock_value, rho, max_step, eta, opt);
+    
+    /* the incremental variant keeps the constraints cached between steps */
+    if ( opt != NULL && opt -> incremental ) return minover_incremental (net, s, locked, n_locked, lock_value, rho, max_step, eta, opt);
+    
+    /* the row of the most violated metabolite */
+    int i0 = 0;
+    
+    double cmu0 = 0.;
+    
+    /* the constraints of all metabolites */
+    double *c = (double *) malloc( net -> Nmet * sizeof (double) );
+    
+    /* the number of threads scanning them */
+    int n_threads = solver_threads (opt, net -> Nmet);
+    
+    int step=0;
+    
+    lazy_fluxes lf;
+    
+    stall_monitor sm;
+    
+    lazy_begin (&lf, net, s, locked, n_locked, lock_value, rho);
+    
+    stall_begin (&sm, opt);
+    
+    /* iterate the algorithm until all constraints are satisfied*/
+    do{
+        
+        /* the constraints of the normalised fluxes, over all rows of the network, and the minimum one */
+        i0 = constraint_scan (net, s, rho, lf.scale, lf.c_locked, c, n_threads, &cmu0);
+        
+        /* if some constraint is unsatisfied, update fluxes */
+        if (cmu0 < 0 ) lazy_update_row (&lf, net, s, rho, update_eta (&lf, net, s, rho, eta, cmu0, i0, opt), i0, NULL, NULL);
+        
+        step++;
+        
+        /* from time to time, clear the rounding errors of the running sum */
+        if ( step % net -> Nmet == 0 ) lazy_rebase (&lf, s, net -> Nreact);
+        
+        /* give up if the violation stopped shrinking */
+        if ( stall_check (&sm, cmu0) ) break;
+        
+    } while (cmu0 < 0 && step < max_step );
+    
+    lazy_end (&lf, s, locked, n_locked, lock_value);
+    
+    free (c);
+    
+    return cmu0 < 0 ? max_step : step;
+    
+}
+
+/* A function to (re)compute all cached constraints and to restore the heap order */
+void refresh_constraints (const network *net, double *s, double rho, double *key, index_heap *h){
+    
+    constraint_values (net, s, rho, 1., NULL, key);
+    
+    heap_build (h);
+}
+
+/* run the minover algorithm for fixed rho value, updating only the constraints touched by each step */
+/* cached constraints refer to the unnormalised fluxes: rows with a locked reaction are kept out of the heap */
+/* because their constant term does not scale with the normalisation */
+int minover_incremental (const network *net, double *s, int *locked, int n_locked, double *lock_value, double rho, int max_step, double eta, solver_options *opt){
+    
+    int i, i0 = 0, step = 0, *dummy_i;
+    
+    double c, cmu0 = 0.;
+    
+    double *key = (double *) malloc( net -> Nmet * sizeof (double) );
+    
+    index_heap h;
+    
+    lazy_fluxes lf;
+    
+    stall_monitor sm;
+    
+    /* the reaction-to-metabolite index is needed to find the rows touched by an update */
+    /* the network is shared by concurrent solves, so it is built beforehand (see network_transpose) */
+    if ( net -> t_start == NULL ){
+        
+        fprintf(stderr, "The incremental minover needs the transpose of the network\n");
+        
+        exit (EXIT_FAILURE);
+    }
+    
+    lazy_begin (&lf, net, s, locked, n_locked, lock_value, rho);
+    
+    stall_begin (&sm, opt);
+    
+    /* all rows without a constant term go to the heap */
+    heap_alloc (&h, net -> Nmet, key);
+    
+    for (i = 0; i < net -> Nmet; i++) if ( *(lf.c_locked + i) == 0. ) heap_push (&h, i);
+    
+    refresh_constraints (net, s, rho, key, &h);
+    
+    /* iterate the algorithm until all constraints are satisfied*/
+    do{
+        
+        /* the most violated constraint among the scaling ones is at the top of the heap */
+        if ( h.n > 0 ){
+            
+            i0 = *(h.item);
+            
+            cmu0 = lf.scale * *(key + i0);
+        }
+        
+        /* the rows with a constant term are compared one by one */
+        for (dummy_i = lf.fixed_rows; dummy_i < lf.fixed_rows + lf.n_fixed; dummy_i++){
+            
+            c = lf.scale * *(key + *dummy_i) + *(lf.c_locked + *dummy_i);
+            
+            if ( (h.n == 0 && dummy_i == lf.fixed_rows) || c < cmu0 || (c == cmu0 && *dummy_i < i0) ){
                 
                 cmu0 = c;
                 
-                dummy0 = dummy_m;
+                i0 = *dummy_i;
             }
+        }
+        
+        /* if some constraint is unsatisfied, update fluxes and cached constraints */
+        if (cmu0 < 0 ) lazy_update_row (&lf, net, s, rho, update_eta (&lf, net, s, rho, eta, cmu0, i0, opt), i0, key, &h);
+        
+        step++;
+        
+        /* from time to time, get rid of the rounding errors accumulated by the cache */
+        if ( step % net -> Nmet == 0 ){
+            
+            lazy_rebase (&lf, s, net -> Nreact);
             
+            refresh_constraints (net, s, rho, key, &h);
         }
         
-        /* if some constraint is unsatisfied, update fluxes */
-        if (cmu0 < 0 ){
+        /* give up if the violation stopped shrinking */
+        if ( stall_check (&sm, cmu0) ) break;
+        
+    } while (cmu0 < 0 && step < max_step );
+    
+    lazy_end (&lf, s, locked, n_locked, lock_value);
+    
+    heap_free (&h);
+    
+    free (key);
+    
+    return cmu0 < 0 ? max_step : step;
+}
+
+/* run the minover relaxation for fixed rho value: sweep over the rows and fix each violated constraint as it is met, */
+/* in row order (cyclic) or in a new random order at each sweep; a step is an update, so each costs the degree of its row */
+/* the fluxes are feasible when a whole sweep needs no update, i.e. after an exact check of all constraints */
+int minover_sweep (const network *net, double *s, int *locked, int n_locked, double *lock_value, double rho, int max_step, double eta, solver_options *opt, rng_state *rng){
+    
+    int i, k, tmp, step = 0, n_updates, *dummy_i;
+    
+    /* the worst constraint of the current sweep and of the last complete one */
+    double c, c_sweep, c_worst = 0.;
+    
+    /* the order of the rows in a sweep */
+    int *order = (int *) malloc( net -> Nmet * sizeof (int) );
+    
+    /* the random order is drawn from the stream of the solve (seeded by --seed, one stream per solve), */
+    /* so that concurrent solves and retries at the same rho get different orders, and runs are reproducible */
+    /* a caller without a stream gets a local one seeded from rho */
+    rng_state local_rng;
+    
+    lazy_fluxes lf;
+    
+    stall_monitor sm;
+    
+    for (i = 0; i < net -> Nmet; i++) *(order + i) = i;
+    
+    if ( rng == NULL ){
+        
+        rng_seed (&local_rng, (uint64_t) (rho * 1.e9) );
+        
+        rng = &local_rng;
+    }
+    
+    lazy_begin (&lf, net, s, locked, n_locked, lock_value, rho);
+    
+    stall_begin (&sm, opt);
+    
+    do{
+        
+        /* shuffle the rows (Fisher - Yates) */
+        if ( opt -> selection == VN_SELECT_RANDOM ) for (i = net -> Nmet - 1; i > 0; i--){
+            
+            k = (int) ( rng_uniform (rng) * (i + 1) );
+            
+            tmp = *(order + i);
+            
+            *(order + i) = *(order + k);
+            
+            *(order + k) = tmp;
+        }
+        
+        n_updates = 0;
+        
+        c_sweep = 0.;
+        
+        for (dummy_i = order; dummy_i < order + net -> Nmet && step < max_step; dummy_i++){
             
-            /*if (rho > 0.986) fprintf(stderr, "\r mu0 %d cmu0 %g \r", (int)(dummy0 - metabs) +1, cmu0);*/
-            /* update (input) reactions attached to metabolite dummy0 */
-            coeff = dummy0 -> input.coeff;
+            /* the constraint of the normalised fluxes */
+            c = lf.scale * row_constraint (net, s, rho, *dummy_i) + *(lf.c_locked + *dummy_i);
             
-            for (s_d = dummy0 -> input.react; s_d < dummy0 -> input.react + dummy0 -> input.n_react; s_d++){
+            if ( c < 0 ){
+                
+                lazy_update_row (&lf, net, s, rho, update_eta (&lf, net, s, rho, eta, c, *dummy_i, opt), *dummy_i, NULL, NULL);
                 
-                /* update the flux according to minover rule. A factor eta is added to ease convergence */
-                **s_d -=  (*coeff) * rho * eta;
+                n_updates++;
                 
-                /* if negative, set to 0 */
-                check_sign = sign(**s_d);
+                step++;
                 
-                **s_d *= (1. + check_sign )/ 2.;
+                if ( c < c_sweep ) c_sweep = c;
                 
-                coeff++;
+                /* give up if the worst violation of the sweeps stopped shrinking */
+                if ( stall_check (&sm, c_worst) ) step = max_step;
             }
+        }
+        
+        c_worst = c_sweep;
+        
+        /* clear the rounding errors of the running sum after each sweep */
+        lazy_rebase (&lf, s, net -> Nreact);
+        
+    } while (n_updates > 0 && step < max_step );
+    
+    lazy_end (&lf, s, locked, n_locked, lock_value);
+    
+    free (order);
+    
+    return n_updates > 0 ? max_step : step;
+}
+
+/* A function to move the k most violated of the n rows listed in rows to its front (in no particular order), by quickselect */
+/* returns the number of rows moved, i.e. k or n if smaller */
+int select_most_violated (int *rows, int n, double *c, int k){
+    
+    int lo = 0, hi = n - 1, i, j, tmp;
+    double pivot;
+    
+    if ( k >= n ) return n;
+    
+    /* partition until the k-th smallest constraint is in place */
+    while (lo < hi){
+        
+        pivot = c[*(rows + (lo + hi) / 2)];
+        
+        i = lo;
+        
+        j = hi;
+        
+        while (i <= j){
+            
+            while ( c[*(rows + i)] < pivot ) i++;
             
-            /* update (output) reactions attached to metabolite dummy0 */
-            coeff = dummy0 -> output.coeff;
+            while ( c[*(rows + j)] > pivot ) j--;
             
-            for (s_d = dummy0 -> output.react; s_d < dummy0 -> output.react + dummy0 -> output.n_react; s_d++){
+            if ( i <= j ){
+                
+                tmp = *(rows + i);
+                
+                *(rows + i) = *(rows + j);
+                
+                *(rows + j) = tmp;
                 
-                /* update the flux according to minover rule. A factor eta is added to ease convergence */
-                **s_d +=  (*coeff) * eta;
+                i++;
                 
-                coeff++;
+                j--;
             }
+        }
+        
+        if ( k - 1 <= j ) hi = j;
+        
+        else if ( k - 1 >= i ) lo = i;
+        
+        else break;
+    }
+    
+    return k;
+}
+
+/* A function to apply the minover updates of the n rows listed in rows together, with steps eta, to the lazily normalised fluxes */
+/* the updates are summed in ds (zero on entry and on exit) as in a Jacobi step, then applied in one pass over the fluxes, */
+/* clipping them at zero; if m is not NULL, it holds the momentum of each flux (in unnormalised units), added as in opt */
+void lazy_update_block (lazy_fluxes *lf, const network *net, double *s, double rho, int *rows, double *eta, int n, double *ds, double *m, solver_options *opt, int n_threads){
+    
+    int k, j, *dummy_i;
+    double inv_scale = 1. / lf -> scale, dsum = 0.;
+    double beta = m != NULL ? opt -> momentum : 0.;
+    int nesterov = m != NULL && opt -> nesterov;
+    
+    /* sum the updates, with the steps expressed in unnormalised units */
+    for (dummy_i = rows; dummy_i < rows + n; dummy_i++){
+        
+        for (k = *(net -> row + *dummy_i); k < *(net -> row + *dummy_i + 1); k++){
             
+            j = *(net -> col + k);
+            
+            /* locked reactions are not updated */
+            if ( *(lf -> is_locked + j) ) continue;
+            
+            /* inputs are weighted by rho */
+            *(ds + j) += *(net -> coeff + k) * ( k < *(net -> split + *dummy_i) ? rho : 1. ) * *(eta + (dummy_i - rows)) * inv_scale;
         }
+    }
+    
+    /* apply them all: fluxes cannot become negative */
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(n_threads) reduction(+:dsum) schedule(static) if(n_threads > 1)
+#endif
+    for (j = 0; j < net -> Nreact; j++){
         
-        /* keep the locked reaction fixed*/
-        coeff = lock_value;
-        for (s_d = locked; s_d < locked + n_locked; s_d++) {
+        double old = s[j], step = *(ds + j);
+        
+        /* the momentum remembers the previous steps: heavy ball, s += m, or Nesterov, s += beta m + ds */
+        if ( m != NULL ){
             
-            **s_d = *coeff;
+            *(m + j) = beta * *(m + j) + *(ds + j);
             
-            coeff++;
+            step = nesterov ? beta * *(m + j) + *(ds + j) : *(m + j);
         }
         
-        normalise_fluxes (s, Nreac, locked, n_locked, lock_value);
+        /* the update is consumed even if the momentum cancels it */
+        *(ds + j) = 0.;
+        
+        if ( step == 0. ) continue;
+        
+        s[j] += step;
+        
+        /* a flux stopped at zero loses its momentum */
+        if ( s[j] < 0. ){
+            
+            s[j] = 0.;
+            
+            if ( m != NULL ) *(m + j) = 0.;
+        }
+        
+        dsum += s[j] - old;
+    }
+    
+    /* keep track of the normalisation */
+    lf -> sum += dsum;
+    
+    lf -> scale = lf -> z_free / lf -> sum;
+}
+
+/* run the minover algorithm for fixed rho value, fixing at each step the block_size most violated constraints */
+/* (or all the violated ones) found by one scan, with their steps damped by opt -> damping */
+/* with momentum, the steps are accumulated over the fluxes and reset whenever the total violation rises */
+int minover_block (const network *net, double *s, int *locked, int n_locked, double *lock_value, double rho, int max_step, double eta, solver_options *opt){
+    
+    int i, n_violated, n_block, step = 0, *dummy_i;
+    
+    double cmu0 = 0., v, v_last = HUGE_VAL, *dummy;
+    
+    /* the constraints of all metabolites */
+    double *c = (double *) malloc( net -> Nmet * sizeof (double) );
+    
+    /* the violated rows, the steps of the block and the summed updates */
+    int *rows = (int *) malloc( net -> Nmet * sizeof (int) );
+    
+    double *eta_b = (double *) malloc( net -> Nmet * sizeof (double) );
+    
+    double *ds = (double *) calloc( net -> Nreact, sizeof (double) );
+    
+    /* the momentum of the fluxes, if any (locked reactions have none, since they are never updated) */
+    double *m = opt -> momentum > 0. ? (double *) calloc( net -> Nreact, sizeof (double) ) : NULL;
+    
+    /* the number of threads scanning them */
+    int n_threads = solver_threads (opt, net -> Nmet);
+    
+    lazy_fluxes lf;
+    
+    stall_monitor sm;
+    
+    lazy_begin (&lf, net, s, locked, n_locked, lock_value, rho);
+    
+    stall_begin (&sm, opt);
+    
+    /* iterate the algorithm until all constraints are satisfied*/
+    do{
+        
+        /* the constraints of the normalised fluxes, over all rows of the network, and the minimum one */
+        constraint_scan (net, s, rho, lf.scale, lf.c_locked, c, n_threads, &cmu0);
+        
+        /* list the violated rows, and keep the most violated ones */
+        n_violated = 0;
+        
+        v = 0.;
+        
+        for (i = 0; i < net -> Nmet; i++){
+            
+            if ( *(c + i) < 0 ){
+                
+                *(rows + n_violated++) = i;
+                
+                v -= *(c + i);
+            }
+        }
+        
+        /* restart: the momentum overshot if the total violation rose */
+        if ( m != NULL && v > v_last ) for (dummy = m; dummy < m + net -> Nreact; dummy++) *dummy = 0.;
+        
+        v_last = v;
+        
+        n_block = opt -> block_size > 0 ? select_most_violated (rows, n_violated, c, opt -> block_size) : n_violated;
+        
+        /* their steps all refer to the fluxes of this scan */
+        for (dummy_i = rows; dummy_i < rows + n_block; dummy_i++) *(eta_b + (dummy_i - rows)) = opt -> damping * update_eta (&lf, net, s, rho, eta, *(c + *dummy_i), *dummy_i, opt);
+        
+        if ( n_block > 0 ) lazy_update_block (&lf, net, s, rho, rows, eta_b, n_block, ds, m, opt, n_threads);
         
         step++;
         
+        /* from time to time, clear the rounding errors of the running sum (the momentum follows the units of the fluxes) */
+        if ( step % net -> Nmet == 0 ){
+            
+            if ( m != NULL ) for (dummy = m; dummy < m + net -> Nreact; dummy++) *dummy *= lf.scale;
+            
+            lazy_rebase (&lf, s, net -> Nreact);
+        }
+        
+        /* give up if the violation stopped shrinking */
+        if ( stall_check (&sm, cmu0) ) break;
+        
     } while (cmu0 < 0 && step < max_step );
     
-    return step;
+    lazy_end (&lf, s, locked, n_locked, lock_value);
+    
+    free (c);
+    
+    free (rows);
+    
+    free (eta_b);
+    
+    free (ds);
+    
+    free (m);
     
+    return cmu0 < 0 ? max_step : step;
 }
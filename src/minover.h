@@ -23,7 +23,89 @@
 #include "metabolites.h"
 #include "sign.h"
 #include "fluxes.h"
+#include "heap.h"
+#include "constraints.h"
+#include "solver_options.h"
+#include "rng.h"
 
-int minover (metabolite *, double *, double **, int, double *, double, int, int, double, int);
+/* the state of the lazily normalised fluxes used inside minover: the normalised free fluxes are scale * s */
+typedef struct{
+    
+    /* the sum the free (i.e. not locked) fluxes must have, i.e. Nreact minus the locked values */
+    double z_free;
+    
+    /* the running sum of the unnormalised free fluxes */
+    double sum;
+    
+    /* the normalisation factor, z_free / sum */
+    double scale;
+    
+    /* 1 for locked reactions */
+    char *is_locked;
+    
+    /* the constant contribution of the locked reactions to each constraint */
+    double *c_locked;
+    
+    /* the number and the list of rows with a non-zero constant term */
+    int n_fixed;
+    
+    int *fixed_rows;
+    
+    /* scratch space for the exact step: the breakpoints of a row and their squared gradients */
+    double *bp_eta;
+    
+    double *bp_g2;
+}lazy_fluxes;
+
+/* the watch on the worst violation, to give up a minover run that no longer converges */
+typedef struct{
+    
+    /* the length of a window (0 to never give up) and the number of windows without progress tolerated */
+    int window;
+    
+    int patience;
+    
+    /* the steps into the current window and the windows without progress so far */
+    int count;
+    
+    int idle;
+    
+    /* the smallest worst violation seen so far, and in the current window */
+    double best;
+    
+    double window_best;
+}stall_monitor;
+
+void lazy_begin (lazy_fluxes *, const network *, double *, int *, int, double *, double);
+
+void lazy_rebase (lazy_fluxes *, double *, int);
+
+void lazy_end (lazy_fluxes *, double *, int *, int, double *);
+
+void lazy_update_row (lazy_fluxes *, const network *, double *, double, double, int, double *, index_heap *);
+
+double row_constraint (const network *, double *, double, int);
+
+double exact_step (lazy_fluxes *, const network *, double *, double, double, int);
+
+double update_eta (lazy_fluxes *, const network *, double *, double, double, double, int, solver_options *);
+
+void stall_begin (stall_monitor *, solver_options *);
+
+int stall_check (stall_monitor *, double);
+
+int minover (const network *, double *, int *, int, double *, double, int, double, solver_options *, rng_state *);
+
+void refresh_constraints (const network *, double *, double, double *, index_heap *);
+
+int minover_incremental (const network *, double *, int *, int, double *, double, int, double, solver_options *);
+
+int minover_sweep (const network *, double *, int *, int, double *, double, int, double, solver_options *, rng_state *);
+
+int select_most_violated (int *, int, double *, int);
+
+void lazy_update_block (lazy_fluxes *, const network *, double *, double, int *, double *, int, double *, double *, solver_options *, int);
+
+int minover_block (const network *, double *, int *, int, double *, double, int, double, solver_options *);
 
 #endif
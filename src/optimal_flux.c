@@ -15,8 +15,12 @@
 
 #include "optimal_flux.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* compute the fluxes up to max rho (or min step), starting from an initial rho value*/
-double optimal_flux (metabolite *metabs, double *s, double **locked, int n_locked, double *lock_value, double *s_backup, int Nmet, int Nreac, int max_step_init, double step_init, double step_min, double rho_min, double rho_max, double eta){
+double optimal_flux (const network *net, flux_state *fs, int max_step_init, double step_init, double step_min, double rho_min, double rho_max, double eta, solver_options *opt){
     
     if (rho_min > rho_max) {
         
@@ -34,77 +38,90 @@ double optimal_flux (metabolite *metabs, double *s, double **locked, int n_locke
         
     }
     
-    double rho = rho_min, step = step_init, eta_factor = 10.;
-    int n_step, max_step = max_step_init;
+    /* the bisection and k-section searches do not use the schedule below */
+    if ( opt != NULL && opt -> search == VN_SEARCH_BISECTION ) return optimal_flux_bisection (net, fs, max_step_init, step_min, rho_min, rho_max, eta, opt, NULL);
+    
+    if ( opt != NULL && opt -> search == VN_SEARCH_KSECTION ) return optimal_flux_ksection (net, fs, max_step_init, step_min, rho_min, rho_max, eta, opt, NULL);
+    
+    int n_step, Nreac = net -> Nreact;
+    
+    /* the fluxes of this solve */
+    double *s = fs -> s, *s_backup = fs -> backup, *lock_value = fs -> lock_value;
+    int *locked = fs -> locked, n_locked = fs -> n_locked;
     
     
     /* initialise fluxes */
-    initialise_fluxes (s, Nreac, locked, n_locked, lock_value);
+    initialise_fluxes (s, Nreac, locked, n_locked, lock_value, &fs -> rng);
     
     
     /* and store values */
     backup_fluxes (s, s_backup, Nreac);
     
+    /* the accepted fluxes the continuation extrapolates from (none if disabled) */
+    flux_path path;
+    
+    flux_path_alloc (&path, opt != NULL ? opt -> continuation : 0, net -> Nmet, Nreac);
+    
+    /* a prediction that failed is not tried again until some rho is accepted */
+    int predict = 1;
+    
+    /* the controller setting rho, its step, eta and the step budget */
+    schedule_controller ctrl;
+    
+    schedule_init (&ctrl, opt != NULL ? opt -> schedule : VN_SCHEDULE_CLASSIC, net, rho_min, rho_max, step_init, max_step_init);
+    
     /* starting from an initial rho value, satisfy constraints for a given rho and increase rho up to rho_max */
     /* if the step becomes too small (i.e. convergence very slow) exit from loop and return last succesful flux array */
-    while (rho < rho_max && step > step_min){
+    while (ctrl.rho < rho_max && ctrl.step > step_min){
+        
+        /* predict the fluxes at the new rho from the accepted ones: minover then acts as a corrector */
+        if ( predict ) flux_path_predict (&path, net, ctrl.rho, s, locked, n_locked, lock_value);
+        
+        schedule_start (&ctrl, net, s);
         
         /* run minover at given rho */
-        n_step = minover (metabs, s, locked, n_locked, lock_value, rho, Nmet, max_step, eta*eta_factor, Nreac);
+        n_step = minover (net, s, locked, n_locked, lock_value, ctrl.rho, ctrl.max_step, eta*ctrl.eta_factor, opt, &fs -> rng);
         
         /* minover returns the number of steps to reach convergence*/
         /* if n steps > max step -> no convergence, restore last succesful value and reduce rho */
-        if (n_step >= max_step) {
+        if (n_step >= ctrl.max_step) {
+            
+            /* the controller sets the next rho, step, eta and budget */
+            schedule_rejected (&ctrl, net, fs, n_step);
             
             /* restore the last succesful array */
             restore_backup ( s, s_backup, Nreac);
             
-            /*decrease rho to last succesful value */
-            rho -= step;
-            
-            /* decrease the step value */
-            step /= 1.5;
-            
-            /* decrease the eta factor */
-            eta_factor /= 1.2;
-            
-            max_step *= 1.5;
-            
+            predict = 0;
         }
         
         else {
             
-            /* if successful, normalise the fluxes */
+            /* if successful, normalise the fluxes (minover only keeps track of the normalisation lazily) */
             normalise_fluxes (s, Nreac, locked, n_locked, lock_value);
             
             
             /* and then backup the flux values */
             backup_fluxes (s, s_backup, Nreac);
             
-            /* if approaching non - convergence, reduce the step size */
-            if ( n_step > 2 * max_step / 3) {
-                
-                step /= 1.2;
-                
-                /* decrease the eta factor */
-                eta_factor /= 1.1;
-                
-                max_step *= 1.2;
-            }
+            flux_path_push (&path, ctrl.rho, s);
+            
+            predict = 1;
+            
+            schedule_accepted (&ctrl, n_step);
         }
-        
-        if (rho == rho_min) eta_factor /= 15.;
-        
-        /* increase rho value */
-        rho += step;
     }
     
-    return rho -step;
+    flux_path_free (&path);
+    
+    schedule_free (&ctrl);
+    
+    return ctrl.rho - ctrl.step;
 }
 
 /* A verbose version of the function above: the only difference is to print rho values while sampling */
 /* compute the fluxes up to max rho (or min step), starting from an initial rho value*/
-double optimal_flux_verbose (metabolite *metabs, double *s, double **locked, int n_locked, double *lock_value, double *s_backup, int Nmet, int Nreac, int max_step_init, double step_init, double step_min, double rho_min, double rho_max, double eta, FILE *log_file){
+double optimal_flux_verbose (const network *net, flux_state *fs, int max_step_init, double step_init, double step_min, double rho_min, double rho_max, double eta, solver_options *opt, FILE *log_file){
     
     if (rho_min > rho_max) {
         
@@ -122,75 +139,351 @@ double optimal_flux_verbose (metabolite *metabs, double *s, double **locked, int
         
     }
     
-    double rho = rho_min, step = step_init, eta_factor = 10.;
-    int n_step, max_step = max_step_init;
+    /* the bisection and k-section searches do not use the schedule below */
+    if ( opt != NULL && opt -> search == VN_SEARCH_BISECTION ) return optimal_flux_bisection (net, fs, max_step_init, step_min, rho_min, rho_max, eta, opt, log_file);
+    
+    if ( opt != NULL && opt -> search == VN_SEARCH_KSECTION ) return optimal_flux_ksection (net, fs, max_step_init, step_min, rho_min, rho_max, eta, opt, log_file);
+    
+    int n_step, Nreac = net -> Nreact;
+    
+    /* the fluxes of this solve */
+    double *s = fs -> s, *s_backup = fs -> backup, *lock_value = fs -> lock_value;
+    int *locked = fs -> locked, n_locked = fs -> n_locked;
     
     
     /* initialise fluxes */
-    initialise_fluxes (s, Nreac, locked, n_locked, lock_value);
+    initialise_fluxes (s, Nreac, locked, n_locked, lock_value, &fs -> rng);
     
     
     /* and store values */
     backup_fluxes (s, s_backup, Nreac);
     
+    /* the accepted fluxes the continuation extrapolates from (none if disabled) */
+    flux_path path;
+    
+    flux_path_alloc (&path, opt != NULL ? opt -> continuation : 0, net -> Nmet, Nreac);
+    
+    /* a prediction that failed is not tried again until some rho is accepted */
+    int predict = 1;
+    
+    /* the controller setting rho, its step, eta and the step budget */
+    schedule_controller ctrl;
+    
+    schedule_init (&ctrl, opt != NULL ? opt -> schedule : VN_SCHEDULE_CLASSIC, net, rho_min, rho_max, step_init, max_step_init);
+    
     /* starting from an initial rho value, satisfy constraints for a given rho and increase rho up to rho_max */
     /* if the step becomes too small (i.e. convergence very slow) exit from loop and return last succesful flux array */
-    while (rho < rho_max && step > step_min){
+    while (ctrl.rho < rho_max && ctrl.step > step_min){
+        
+        /* predict the fluxes at the new rho from the accepted ones: minover then acts as a corrector */
+        if ( predict ) flux_path_predict (&path, net, ctrl.rho, s, locked, n_locked, lock_value);
+        
+        schedule_start (&ctrl, net, s);
         
         /* run minover at given rho */
-        n_step = minover (metabs, s, locked, n_locked, lock_value, rho, Nmet, max_step, eta*eta_factor, Nreac);
+        n_step = minover (net, s, locked, n_locked, lock_value, ctrl.rho, ctrl.max_step, eta*ctrl.eta_factor, opt, &fs -> rng);
         
         /* minover returns the number of steps to reach convergence*/
         /* if n steps > max step -> no convergence, restore last succesful value and reduce rho */
-        if (n_step >= max_step) {
+        if (n_step >= ctrl.max_step) {
+            
+            /* the controller sets the next rho, step, eta and budget */
+            schedule_rejected (&ctrl, net, fs, n_step);
             
             /* restore the last succesful array */
             restore_backup ( s, s_backup, Nreac);
             
-            /*decrease rho to last succesful value */
-            rho -= step;
-            
-            /* decrease the step value */
-            step /= 1.5;
-            
-            /* decrease the eta factor */
-            eta_factor /= 1.2;
-            
-            max_step *= 1.5;
-            
+            predict = 0;
         }
         
         else {
             
-            /* if successful, normalise the fluxes */
+            /* if successful, normalise the fluxes (minover only keeps track of the normalisation lazily) */
             normalise_fluxes (s, Nreac, locked, n_locked, lock_value);
             
             
             /* and then backup the flux values */
             backup_fluxes (s, s_backup, Nreac);
             
-            /* if approaching non - convergence, reduce the step size */
-            if ( n_step > 2 * max_step / 3) {
-                
-                step /= 1.2;
-                
-                /* decrease the eta factor */
-                eta_factor /= 1.1;
-                
-                max_step *= 1.2;
-            }
+            flux_path_push (&path, ctrl.rho, s);
+            
+            predict = 1;
+            
+            schedule_accepted (&ctrl, n_step);
         }
         
-        if (rho == rho_min) eta_factor /= 15.;
         
-        /* increase rho value */
-        rho += step;
         
+        fprintf(log_file, "\r step %g rho %g ", ctrl.step, ctrl.rho);
+    }
+    
+    fprintf(log_file, "\n");
+    
+    flux_path_free (&path);
+    
+    schedule_free (&ctrl);
+    
+    return ctrl.rho - ctrl.step;
+}
+
+/* A function to test whether rho is feasible, running minover from the fluxes in fs -> s (the backup, unless resuming) */
+/* if so, the fluxes are normalised and become the new backup; otherwise they are those minover stopped at, and the */
+/* caller restores the backup (see try_rho_search) */
+int try_rho (const network *net, flux_state *fs, double rho, int max_step, double eta, solver_options *opt){
+    
+    int n_step = minover (net, fs -> s, fs -> locked, fs -> n_locked, fs -> lock_value, rho, max_step, eta, opt, &fs -> rng);
+    
+    /* no convergence within max_step */
+    if (n_step >= max_step) return 0;
+    
+    normalise_fluxes (fs -> s, fs -> Nreact, fs -> locked, fs -> n_locked, fs -> lock_value);
+    
+    backup_fluxes (fs -> s, fs -> backup, fs -> Nreact);
+    
+    return 1;
+}
+
+/* A function to test whether rho is feasible as try_rho does, but asking the exact engine (if opt -> exact) first: */
+/* returns 1 if minover converged, 0 if it failed, -1 if the simplex proved rho infeasible (the fluxes are left as they */
+/* are), and 2 if minover failed on a rho the simplex found feasible. The simplex only certifies rho: when minover fails */
+/* on a feasible rho, it starts again half way to the vertex of the simplex, so that the fluxes are still a sample of it */
+/* if the simplex itself fails, minover alone decides */
+int try_rho_exact (const network *net, flux_state *fs, double rho, int max_step, double eta, solver_options *opt){
+    
+    int feasible = -1, result;
+    
+    double *vertex = NULL, *dummy, *dummy_v;
+    
+    if ( opt != NULL && opt -> exact ){
         
+        vertex = (double *) malloc( fs -> Nreact * sizeof (double) );
         
-        fprintf(log_file, "\r step %g rho %g ", step, rho);
+        feasible = lp_feasible (net, fs, rho, vertex, NULL);
     }
     
-    fprintf(log_file, "\n");
-    return rho -step;
+    /* the simplex proves some rho infeasible, sparing the whole minover budget */
+    if ( feasible == 0 ) result = -1;
+    
+    else if ( try_rho (net, fs, rho, max_step, eta, opt) ) result = 1;
+    
+    else if ( feasible < 0 ) result = 0;
+    
+    else {
+        
+        /* the constraints are linear: half way from the fluxes minover stopped at, they are violated half as much */
+        normalise_fluxes (fs -> s, fs -> Nreact, fs -> locked, fs -> n_locked, fs -> lock_value);
+        
+        for (dummy = fs -> s, dummy_v = vertex; dummy < fs -> s + fs -> Nreact; dummy++, dummy_v++) *dummy = 0.5 * (*dummy + *dummy_v);
+        
+        result = try_rho (net, fs, rho, max_step, eta, opt) ? 1 : 2;
+    }
+    
+    free (vertex);
+    
+    return result;
+}
+
+/* A function to test rho as try_rho_exact does, trying it again up to retries times after a failure that may only mean */
+/* that the step is too coarse or the budget too small: as in the schedule, each failure makes eta_factor smaller and */
+/* max_step larger, and the new values are kept for the next calls. Returns 1 if rho was found feasible; otherwise the */
+/* backup is restored */
+int try_rho_search (const network *net, flux_state *fs, double rho, int *max_step, double eta, double *eta_factor, int retries, solver_options *opt){
+    
+    int result, attempt;
+    
+    for (attempt = 0; ; attempt++){
+        
+        result = try_rho_exact (net, fs, rho, *max_step, eta * *eta_factor, opt);
+        
+        if ( result == 1 ) return 1;
+        
+        /* the simplex proved rho infeasible */
+        if ( result < 0 ) return 0;
+        
+        *eta_factor /= 1.2;
+        
+        *max_step = grow_budget (*max_step, 1.5);
+        
+        /* a rho the simplex found feasible gets the retries of the ends of the bracket */
+        if ( result == 2 && retries < SEARCH_RETRIES ) retries = SEARCH_RETRIES;
+        
+        if ( attempt >= retries ){
+            
+            restore_backup (fs -> s, fs -> backup, fs -> Nreact);
+            
+            return 0;
+        }
+        
+        /* the next try resumes from the fluxes minover stopped at, so that the tries add up */
+        normalise_fluxes (fs -> s, fs -> Nreact, fs -> locked, fs -> n_locked, fs -> lock_value);
+    }
+}
+
+/* compute the fluxes at the maximal rho by bisection, down to a bracket of width tol */
+/* every solve is warm-started from the fluxes of the largest feasible rho found so far */
+/* with opt -> exact, each rho is checked by the simplex first (see try_rho_exact) */
+/* rho_min and rho_max are tried SEARCH_RETRIES more times before a failure moves the bracket past them */
+/* progress is printed to log_file, unless NULL */
+double optimal_flux_bisection (const network *net, flux_state *fs, int max_step, double tol, double rho_min, double rho_max, double eta, solver_options *opt, FILE *log_file){
+    
+    double lo, hi, mid, eta_factor = 10.;
+    
+    /* initialise fluxes */
+    initialise_fluxes (fs -> s, fs -> Nreact, fs -> locked, fs -> n_locked, fs -> lock_value, &fs -> rng);
+    
+    /* and store values */
+    backup_fluxes (fs -> s, fs -> backup, fs -> Nreact);
+    
+    /* every solve uses the larger step the schedule keeps for its first one: a warm-started solve can still be
+       far from feasible after a jump of the bracket, and the step shrinks only when a solve runs out of steps */
+    if ( try_rho_search (net, fs, rho_min, &max_step, eta, &eta_factor, SEARCH_RETRIES, opt) ){
+        
+        lo = rho_min;
+        
+        hi = rho_max;
+    }
+    
+    /* otherwise the bracket is below rho_min: any fluxes satisfy rho = 0 */
+    else {
+        
+        lo = 0.;
+        
+        hi = rho_min;
+    }
+    
+    /* rho_max itself may be feasible */
+    if ( lo < hi && lo == rho_min && try_rho_search (net, fs, rho_max, &max_step, eta, &eta_factor, SEARCH_RETRIES, opt) ) lo = hi;
+    
+    /* halve the bracket until it is narrow enough: the midpoints are not tried again, a failure only makes the next solves finer */
+    while (hi - lo > tol){
+        
+        mid = 0.5 * (lo + hi);
+        
+        if ( try_rho_search (net, fs, mid, &max_step, eta, &eta_factor, 0, opt) ) lo = mid;
+        
+        else hi = mid;
+        
+        if ( log_file != NULL ) fprintf(log_file, "\r rho in [%g, %g] ", lo, hi);
+    }
+    
+    if ( log_file != NULL ) fprintf(log_file, "\n");
+    
+    /* the fluxes are those of lo */
+    return lo;
+}
+
+/* compute the fluxes at the maximal rho by k-section: each round tests opt -> search_workers values of rho at once */
+/* (one per thread), all warm-started from the fluxes of lo, so that the bracket shrinks by a factor search_workers + 1 */
+/* rho_min and rho_max are first tried alone, as in the bisection; the threads of the candidates share those available */
+/* (main does not run it inside the -j jobs), and the threads scanning the constraints of each candidate share them too */
+/* progress is printed to log_file, unless NULL */
+double optimal_flux_ksection (const network *net, flux_state *fs, int max_step, double tol, double rho_min, double rho_max, double eta, solver_options *opt, FILE *log_file){
+    
+    int n_workers = opt -> search_workers > 1 ? opt -> search_workers : 1, n_team = n_workers, k, best, Nreac = fs -> Nreact;
+    
+    double lo, hi, eta_factor = 10.;
+    
+    /* the options of the candidates, whose scans get their share of the threads */
+    solver_options opt_k = *opt;
+    
+#ifdef _OPENMP
+    if ( n_team > omp_get_max_threads () ) n_team = omp_get_max_threads ();
+#endif
+    
+    if ( opt_k.n_threads > 1 ) opt_k.n_threads = opt_k.n_threads / n_team > 1 ? opt_k.n_threads / n_team : 1;
+    
+    /* the candidates, their fluxes and whether minover converged */
+    double *rho_k = (double *) malloc( n_workers * sizeof (double) );
+    
+    double *s_k = (double *) malloc( (size_t) n_workers * Nreac * sizeof (double) );
+    
+    int *converged = (int *) malloc( n_workers * sizeof (int) );
+    
+    /* the candidates are solved concurrently: each gets a stream of its own, seeded from the stream of the solve */
+    rng_state *rng_k = (rng_state *) malloc( n_workers * sizeof (rng_state) );
+    
+    for (k = 0; k < n_workers; k++) rng_seed (rng_k + k, rng_next (&fs -> rng) );
+    
+    /* initialise fluxes */
+    initialise_fluxes (fs -> s, Nreac, fs -> locked, fs -> n_locked, fs -> lock_value, &fs -> rng);
+    
+    /* and store values */
+    backup_fluxes (fs -> s, fs -> backup, Nreac);
+    
+    /* every solve uses the larger step the schedule keeps for its first one: a warm-started solve can still be
+       far from feasible after a jump of the bracket, and the step shrinks only when a solve runs out of steps */
+    if ( try_rho_search (net, fs, rho_min, &max_step, eta, &eta_factor, SEARCH_RETRIES, opt) ){
+        
+        lo = rho_min;
+        
+        hi = rho_max;
+    }
+    
+    /* otherwise the bracket is below rho_min: any fluxes satisfy rho = 0 */
+    else {
+        
+        lo = 0.;
+        
+        hi = rho_min;
+    }
+    
+    /* rho_max itself may be feasible */
+    if ( lo < hi && lo == rho_min && try_rho_search (net, fs, rho_max, &max_step, eta, &eta_factor, SEARCH_RETRIES, opt) ) lo = hi;
+    
+    while (hi - lo > tol){
+        
+        /* the candidates split the bracket evenly */
+        for (k = 0; k < n_workers; k++) *(rho_k + k) = lo + (k + 1) * (hi - lo) / (n_workers + 1);
+        
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(n_team) schedule(static, 1)
+#endif
+        for (k = 0; k < n_workers; k++){
+            
+            restore_backup (s_k + (size_t) k * Nreac, fs -> backup, Nreac);
+            
+            *(converged + k) = minover (net, s_k + (size_t) k * Nreac, fs -> locked, fs -> n_locked, fs -> lock_value, *(rho_k + k), max_step, eta * eta_factor, &opt_k, rng_k + k) < max_step;
+        }
+        
+        /* the largest feasible candidate becomes lo */
+        best = -1;
+        
+        for (k = 0; k < n_workers; k++) if ( *(converged + k) ) best = k;
+        
+        if ( best >= 0 ){
+            
+            lo = *(rho_k + best);
+            
+            restore_backup (fs -> s, s_k + (size_t) best * Nreac, Nreac);
+            
+            normalise_fluxes (fs -> s, Nreac, fs -> locked, fs -> n_locked, fs -> lock_value);
+            
+            backup_fluxes (fs -> s, fs -> backup, Nreac);
+        }
+        
+        /* the next one becomes hi; a failure may only mean that the step is too coarse, as in the schedule */
+        if ( best < n_workers - 1 ){
+            
+            hi = *(rho_k + best + 1);
+            
+            eta_factor /= 1.2;
+            
+            max_step = grow_budget (max_step, 1.5);
+        }
+        
+        if ( log_file != NULL ) fprintf(log_file, "\r rho in [%g, %g] ", lo, hi);
+    }
+    
+    if ( log_file != NULL ) fprintf(log_file, "\n");
+    
+    free (rho_k);
+    
+    free (s_k);
+    
+    free (converged);
+    
+    free (rng_k);
+    
+    /* the fluxes are those of lo */
+    return lo;
 }
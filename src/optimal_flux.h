@@ -22,9 +22,28 @@
 
 #include "metabolites.h"
 #include "minover.h"
+#include "solver_options.h"
+#include "flux_state.h"
+#include "continuation.h"
+#include "schedule.h"
+#include "simplex.h"
 
-double optimal_flux (metabolite *, double *, double **, int, double *, double *, int, int, int, double, double, double, double, double);
+/* the number of times the searches try the ends of their bracket again before moving past them */
+/* (the budget grows by 1.5 each time, so that the last try gets about ten times the steps of the first) */
+#define SEARCH_RETRIES 6
 
-double optimal_flux_verbose (metabolite *, double *, double **, int, double *, double *, int, int, int, double, double, double, double, double, FILE *);
+double optimal_flux (const network *, flux_state *, int, double, double, double, double, double, solver_options *);
+
+double optimal_flux_verbose (const network *, flux_state *, int, double, double, double, double, double, solver_options *, FILE *);
+
+int try_rho (const network *, flux_state *, double, int, double, solver_options *);
+
+int try_rho_exact (const network *, flux_state *, double, int, double, solver_options *);
+
+int try_rho_search (const network *, flux_state *, double, int *, double, double *, int, solver_options *);
+
+double optimal_flux_bisection (const network *, flux_state *, int, double, double, double, double, solver_options *, FILE *);
+
+double optimal_flux_ksection (const network *, flux_state *, int, double, double, double, double, solver_options *, FILE *);
 
 #endif
@@ -21,340 +21,212 @@
 /*                                                                                          */
 /********************************************************************************************/
 
-/* A function to free the parser structure */
-/* this structure is used to store metabolites when reading a reaction list */
-void parser_free ( metabolite_parse **met, int Nmet){
+/* A function to hash a metabolite name (32 bit FNV-1a) */
+uint32_t name_hash (span name){
     
-    metabolite_parse *dummy;
+    uint32_t h = 2166136261u;
     
-    /* loop over parsed metabolites */
-    for (dummy = *met; dummy < (*met) + Nmet; dummy++) {
-        
-        /* free the name string */
-        free( dummy -> name);
-        
-        /* for the inputs */
-        /* free the index of reactions they're attached to */
-        free( dummy -> input.which_r);
-        
-        /* free the coefficients they are attached to */
-        free( dummy -> input.coeff);
-
-        /* for the outputs */
-        /* free the index of reactions they're attached to */
-        free( dummy -> output.which_r);
-        
-        /* free the coefficients they are attached to */
-        free( dummy -> output.coeff);
-    }
+    const char *c;
     
-    free(*met);
+    for (c = name.begin; c < name.end; c++) h = (h ^ (uint32_t) (unsigned char) *c) * 16777619u;
     
-    return;
+    return h;
 }
 
-
-/* A function to check wheter a metabolite has been already encountered */
-metabolite_parse *find_metabolite (metabolite_parse *raw_metabs, int n_mets, char *met_name){
+/* A function to allocate an empty name table from an arena, with room for about n names before growing */
+/* there is no function to free the table: it goes with the arena */
+void metabolite_index_init (metabolite_index *index, arena *mem, int n){
+    
+    int *dummy;
+    
+    if ( n < 1 ) n = 1;
+    
+    index -> mem = mem;
     
-    metabolite_parse *raw = raw_metabs;
+    /* keep the table at most half full */
+    index -> n_slots = 16;
     
-    /* loop over parsed metabolites */
-    while ( raw < raw_metabs + n_mets && strcmp(met_name, raw -> name) != 0 )  raw++;
+    while ( index -> n_slots < 2 * n ) index -> n_slots *= 2;
     
-    /* return a pointer: */
-    /* if closer to raw_metabs than n_mets, the matbolite is already in the list */
-    return raw;
+    index -> n_used = 0;
+    
+    index -> slot = (int *) arena_alloc ( mem, index -> n_slots * sizeof (int) );
+    
+    index -> hash = (uint32_t *) arena_alloc ( mem, index -> n_slots * sizeof (uint32_t) );
+    
+    for (dummy = index -> slot; dummy < index -> slot + index -> n_slots; dummy++) *dummy = -1;
+    
+    index -> n_allowed = n;
+    
+    index -> name = (char **) arena_alloc ( mem, n * sizeof (char *) );
 }
 
-/* A function to append a new metabolite to the metabolite_parse structure */
-void append_new_met (char *met_name, metabolite_parse **raw_metabs, int n_mets, int *n_allowed) {
+/* A function to store metabolite which, whose name has hash h, in the name table */
+void metabolite_index_add (metabolite_index *index, uint32_t h, int which){
     
-    char *dummy1, *dummy2;
-    int name_l = strlen(met_name);
+    int i, k, n_old = index -> n_slots, *old_slot = index -> slot;
     
-    /* if the # of metabolites is too large, realloc the structure */
-    if ( n_mets >= *n_allowed ) {
+    uint32_t *old_hash = index -> hash;
+    
+    /* if the table would be more than half full, double it and move the stored names */
+    if ( 2 * (index -> n_used + 1) > index -> n_slots ){
         
-        /* double the number of allowed metabolites */
-        *n_allowed *= 2;
+        index -> n_slots *= 2;
         
-        /* realloc */
-        *raw_metabs = (metabolite_parse *) realloc(*raw_metabs, *n_allowed * sizeof( metabolite_parse ) );
+        index -> slot = (int *) arena_alloc ( index -> mem, index -> n_slots * sizeof (int) );
         
-    }
-    
-    /* allocate a char array for the name string */
-    ( (*raw_metabs) + n_mets )  -> name = (char *) malloc( (name_l + 1) * sizeof(char) );
-    
-    /* associate the name to the newly added metabolite */
-    /* initialise a pointer metabolite_parse name string */
-    dummy1 = ((*raw_metabs) + n_mets)  -> name;
-    
-    /* initialise a pointer to the name */
-    dummy2 = met_name;
-    
-    /* copy one string onto the other */
-    while ( *dummy2 != '\0'){
+        index -> hash = (uint32_t *) arena_alloc ( index -> mem, index -> n_slots * sizeof (uint32_t) );
+        
+        for (i = 0; i < index -> n_slots; i++) *(index -> slot + i) = -1;
         
-        *dummy1 = *dummy2;
+        for (k = 0; k < n_old; k++){
+            
+            if ( *(old_slot + k) < 0 ) continue;
+            
+            /* the first empty slot from the home one */
+            for (i = *(old_hash + k) & (index -> n_slots - 1); *(index -> slot + i) >= 0; i = (i + 1) & (index -> n_slots - 1));
+            
+            *(index -> slot + i) = *(old_slot + k);
+            
+            *(index -> hash + i) = *(old_hash + k);
+        }
         
-        dummy1++;
+        /* the old table is no longer needed */
+        arena_release (index -> mem, old_slot);
         
-        dummy2++;
+        arena_release (index -> mem, old_hash);
     }
     
-    /* finalise the copied string */
-    *dummy1 = '\0';
+    /* the first empty slot from the home one */
+    for (i = h & (index -> n_slots - 1); *(index -> slot + i) >= 0; i = (i + 1) & (index -> n_slots - 1));
     
-    /* initialise the reaction attached to the newly found metabolite */
-    ((*raw_metabs) + n_mets) -> input.n_react = 0;
+    *(index -> slot + i) = which;
     
-    ((*raw_metabs) + n_mets) -> output.n_react = 0;
+    *(index -> hash + i) = h;
     
-    /* initialise the number of reactions that can be associated to the metabolite */
-    ((*raw_metabs) + n_mets) -> input.n_allowed = 10;
-    
-    ((*raw_metabs) + n_mets) -> output.n_allowed = 10;
-    
-    /* allocate memory for the reactions and the coefficients */
-    ((*raw_metabs) + n_mets) -> input.which_r = (int *) malloc( ( ( (*raw_metabs) + n_mets ) -> input.n_allowed ) * sizeof( int) );
-    
-    ((*raw_metabs) + n_mets) -> output.which_r = (int *) malloc( ( ( (*raw_metabs) + n_mets ) -> output.n_allowed ) * sizeof( int) );
-    
-    ((*raw_metabs) + n_mets) -> input.coeff = (double *) malloc( ( ( (*raw_metabs) + n_mets ) -> input.n_allowed ) * sizeof( double ) );
+    index -> n_used++;
+}
+
+/* A function to check wheter a metabolite, whose name has hash h, has been already encountered */
+/* return its index, or -1 if the name is new */
+int find_metabolite (metabolite_index *index, span met_name, uint32_t h){
     
-    ((*raw_metabs) + n_mets) -> output.coeff = (double *) malloc( ( ( (*raw_metabs) + n_mets ) -> output.n_allowed ) * sizeof( double) );
+    int i;
     
+    /* probe the slots from the home one, until an empty slot */
+    for (i = h & (index -> n_slots - 1); *(index -> slot + i) >= 0; i = (i + 1) & (index -> n_slots - 1)){
+        
+        if ( *(index -> hash + i) == h && span_equal (met_name, *(index -> name + *(index -> slot + i))) ) return *(index -> slot + i);
+    }
     
+    return -1;
 }
 
-/* A function to update the i/o coefficients & reactions */
-/* when a metabolite is found in some new reaction       */
-void update_io (adjacency_parse *io, int which, double coeff){
+/* A function to append a new metabolite, whose name has hash h, to the name table */
+/* return the index of the new metabolite */
+int append_new_met (metabolite_index *index, span met_name, uint32_t h) {
+    
+    size_t name_l = (size_t) (met_name.end - met_name.begin);
     
-    /* if exceeding the number of allowed reactions, realloc the arrays */
-    if ( io -> n_react >= io -> n_allowed ){
+    int which = index -> n_used;
+    
+    /* if the # of metabolites is too large, realloc the names */
+    if ( which >= index -> n_allowed ) {
         
-        /* double the number of allowed reactions */
-        io -> n_allowed *= 2;
+        /* double the number of allowed metabolites */
+        index -> n_allowed *= 2;
         
         /* realloc */
-        io -> which_r = (int *) realloc (io -> which_r, (io -> n_allowed) * sizeof ( int) );
-        
-        io -> coeff = (double *) realloc (io -> coeff, (io -> n_allowed) * sizeof ( double) );
+        index -> name = (char **) arena_grow (index -> mem, index -> name, which * sizeof( char * ), index -> n_allowed * sizeof( char * ) );
     }
     
-    /* associate the reaction index to the reactions array */
-    *(io -> which_r + io -> n_react) = which;
+    /* copy the name into the arena, and finalise the copied string */
+    *(index -> name + which) = (char *) arena_alloc (index -> mem, name_l + 1);
     
-    /* associate the coefficient to the coefficient array */
-    *(io -> coeff + io -> n_react) = coeff;
+    memcpy ( *(index -> name + which), met_name.begin, name_l);
     
-    /* increase the number of associated reactions */
-    io -> n_react++;
-    
-}
-
-/* A function to update the metabolite_parse structure */
-/* when a metabolite is found in some new reaction     */
-void update_metabolite (metabolite_parse *met, int react, double coeff, int io) {
+    *( *(index -> name + which) + name_l) = '\0';
     
-    /* if io negative update the input information */
-    if (io == -1) update_io ( &(met->input), react, coeff);
+    /* the name can now be found through the table */
+    metabolite_index_add (index, h, which);
     
-    /* if io negative update the output information */
-    else update_io ( &(met->output), react, coeff);
+    return which;
 }
 
-/* A function to parse a string containing information on a metabolite */
-void single_met_parse (char *parse1, char *parse2, int *n_allowed, metabolite_parse **raw_metabs, int *n_mets, int which_r, int io){
-    
-    char *parse3, *coeff_met_raw, *coeff_met, *met_name;
-    double coeff;
-    metabolite_parse *new_met;
-    
-    /* get the substring containing the metabolite name and the stoichiometric coefficient */
-    coeff_met_raw = get_substring (parse1, parse2);
+/* A function to parse a piece of a reaction holding a metabolite, i.e. "coefficient name" or just "name" */
+/* the metabolite is added to the list of entries as an input (io = -1) or an output (io = 1) of reaction which_r */
+void single_met_parse (span piece, int which_r, int io, metabolite_index *index, entry_list *entries){
     
-    coeff_met = coeff_met_raw;
+    const char *space;
+    double coeff = 1.;
+    span met_name;
+    uint32_t h;
+    int which;
     
-    /* get rid of the trailing space */
-    while ( *coeff_met == ' ') coeff_met ++;
+    /* get rid of the space around the piece */
+    piece = span_trim (piece);
     
-    /* get rid of space at the end of string */
-    while ( * ( coeff_met_raw + strlen(coeff_met_raw) - 1 ) == ' ') * ( coeff_met_raw + strlen(coeff_met_raw) - 1 ) = '\0';
+    /* find a space in the middle of the piece */
+    space = span_find (piece, ' ');
     
-    /* find a space in the middle of the string */
-    parse3 = strchr(coeff_met, ' ');
-    
-    /* if there is a space, the string is "coeff_space_metabolite" */
-    if (parse3 != NULL){
-        
-        /* the metabolite name is right after the space */
-        met_name = parse3+1;
-        
-        /* get rid of trailing space */
-        while ( *met_name == ' ') met_name ++;
-        
-        /* get rid of space at the end of name */
-        while ( * ( met_name + strlen(met_name) - 1 ) == ' ') * ( met_name + strlen(met_name) - 1 ) = '\0';
-        
-        /* check if newly encountered metabolite */
-        new_met = find_metabolite (*raw_metabs, *n_mets, met_name);
-        
-        /* if new metabolite, append it to the list and increase number of metabolites */
-        if ( (int) (new_met - *raw_metabs) >= *n_mets) {
-            
-            /* append the metabolite */
-            append_new_met (met_name, raw_metabs, *n_mets, n_allowed);
-            
-            /* get a pointer to the appended metabolite */
-            new_met = (*raw_metabs) + (*n_mets);
-            
-            /* increase the number of metabolites */
-            (*n_mets)++;
-        }
-        
-        /* cut the string at the space position */
-        *parse3 = '\0';
+    /* if there is a space, the piece is "coeff_space_metabolite" */
+    if ( space != NULL ){
         
         /* get the coefficient value */
-        coeff = atof(coeff_met);
-        
-        /* undo the truncation */
-        *parse3 = ' ';
-        
-        /* update metabolite information */
-        update_metabolite (new_met, which_r, coeff, io);
-        
+        coeff = span_to_double (span_of (piece.begin, space) );
         
+        /* the metabolite name is right after the space */
+        met_name = span_trim (span_of (space + 1, piece.end) );
     }
     
     /* if there is no space, there is no coefficient, i.e. coefficient = 1 */
-    else{
-        
-        /* get the metabolite's name from the string */
-        met_name = coeff_met;
-        
-        /* get rid of trailing space */
-        while ( *met_name == ' ') met_name ++;
-        
-        /* get rid of space at the end of name */
-        while ( * ( met_name + strlen(met_name) - 1 ) == ' ') * ( met_name + strlen(met_name) - 1 ) = '\0';
-        
-        /* sinks/sources don't have products/substrates: add a metabolite only if its name is longer than 0 */
-        if ( strlen(met_name) > 0 ){
-            /* if so... */
-            /* check whether it is a new metabolite*/
-            new_met = find_metabolite (*raw_metabs, *n_mets, met_name);
-            
-            /* if new metabolite, append it to the list and increase number of metabolites */
-            if ( (int) (new_met - *raw_metabs) >= *n_mets) {
-                
-                /* append the metabolite */
-                append_new_met (met_name, raw_metabs, *n_mets, n_allowed);
-                
-                /* get a pointer to the appended metabolite */
-                new_met = (*raw_metabs) + (*n_mets);
-                
-                /* increase the number of metabolites */
-                (*n_mets)++;
-            }
-            
-            /* coefficient can be 1 only */
-            coeff = 1.;
-            
-            /* update metabolite information */
-            update_metabolite (new_met, which_r, coeff, io);
-        }
-    }
+    else met_name = piece;
+    
+    /* sinks/sources don't have products/substrates: add a metabolite only if its name is longer than 0 */
+    if ( met_name.end == met_name.begin ) return;
     
-    /* free the substring containing the metabolite name and the stoichiometric coefficient */
-    free( coeff_met_raw );
+    /* check whether it is a new metabolite*/
+    h = name_hash (met_name);
+    
+    which = find_metabolite (index, met_name, h);
+    
+    /* if new metabolite, append it to the table */
+    if ( which < 0 ) which = append_new_met (index, met_name, h);
+    
+    /* inputs are stored with a negative sign */
+    entry_list_add (entries, which, which_r, io * coeff);
 }
 
 /* A function to parse the substrates and products of a reaction, which separates metabolites via the "+" sign */
-void parse_subs_prods ( char *react, int *n_allowed, metabolite_parse **raw_metabs, int *n_all_mets, int which_r, int io){
+void parse_subs_prods (span react, int which_r, int io, metabolite_index *index, entry_list *entries){
     
-    char *parse1 = react, *parse2;
+    span piece;
     
-    /* if there is no "+" sign, there's one metabolite only */
-    if ( strchr(parse1, '+') == NULL ) {
-        
-        /* get to the end of the string */
-        parse2 = parse1 + strlen(parse1);
-        
-        /* parse the metabolite */
-        single_met_parse (parse1, parse2, n_allowed, raw_metabs, n_all_mets, which_r, io);
-        
-        
-    }
-    
-    /* otherwise, separate metabolites by the "+" */
-    else {
-        
-        /* for all substrates (or products) */
-        while ( strchr(parse1, '+') != NULL ){
-            
-            /* get the substring within 2 consecutive "+" */
-            parse2 = strchr(parse1, '+');
-            
-            /* parse the metabolite */
-            single_met_parse (parse1, parse2, n_allowed, raw_metabs, n_all_mets, which_r, io);
-            
-            /* get to the next metabolite */
-            parse1 = parse2 +1;
-            
-            
-        }
-        
-        /* get to the last metabolite */
-        parse2 = parse1 + strlen(parse1);
-        
-        /* parse the metabolite */
-        single_met_parse (parse1, parse2, n_allowed, raw_metabs, n_all_mets, which_r, io);
-        
-    }
-    
-    return;
+    /* for all substrates (or products), within 2 consecutive "+" */
+    while ( span_split (&react, '+', &piece) ) single_met_parse (piece, which_r, io, index, entries);
 }
 
-/* A function to parse a reaction string */
-void parse_react_line (char *line, int *n_allowed, metabolite_parse **raw_metabs, int *n_all_mets, int which_r){
+/* A function to parse a reaction line, "name: substrates --> products" (the name is optional) */
+void parse_react_line (span line, int which_r, metabolite_index *index, entry_list *entries){
     
     /* arrow1 is a pointer to the end of substrates, arrow2 to the beginning of products */
-    char *subs, *prods, *colon = strchr(line, ':'), *arrow1 = strchr(line, '-'), *arrow2 = strchr(line, '>');
+    const char *colon = span_find (line, ':'), *arrow1, *arrow2;
     
     /* ignore whatever comes before the ":" */
-    if (colon == NULL ) colon = line;
+    if ( colon != NULL ) line.begin = colon + 1;
     
-    /* remove trailing space from substrates */
-    if ( *( colon + 1) == ' ') colon +=1;
+    /* the products begin after the ">" of the arrow, the substrates end where its "-" (or "<", "=") begin */
+    arrow2 = span_find (line, '>');
     
-    /* remove trailing space from products */
-    if ( *( arrow2 + 1) == ' ') arrow2 +=1;
+    if ( arrow2 == NULL ) arrow2 = line.end;
     
-    /* get string of substrates */
-    subs = get_substring (colon + 1, arrow1);
-    
-    /* get string of proucts */
-    prods = get_substring (arrow2 + 1, line + strlen( line ) );
+    for (arrow1 = arrow2; arrow1 > line.begin && ( *(arrow1 - 1) == '-' || *(arrow1 - 1) == '<' || *(arrow1 - 1) == '=' ); arrow1--);
     
     /* parse substrates */
-    parse_subs_prods (subs, n_allowed, raw_metabs, n_all_mets, which_r, -1);
+    parse_subs_prods (span_of (line.begin, arrow1), which_r, -1, index, entries);
     
     /* parse products */
-    parse_subs_prods (prods, n_allowed, raw_metabs, n_all_mets, which_r, +1);
-    
-    /* free substrates string */
-    free (subs);
-    
-    /* free products string */
-    free (prods);
-    
-    return;
-    
+    parse_subs_prods (span_of (arrow2 < line.end ? arrow2 + 1 : line.end, line.end), which_r, +1, index, entries);
 }
 
 /***********************************************************************************/
@@ -363,51 +235,33 @@ void parse_react_line (char *line, int *n_allowed, metabolite_parse **raw_metabs
 /*                                                                                 */
 /***********************************************************************************/
 
-/* A function to get the (char) file size */
-long get_file_size (FILE *in_stream){
-    
-    long input_file_size;
-    
-    /* get to the end of file */
-    fseek(in_stream, 0, SEEK_END);
+/* A function to tell whether a line holds data, i.e. it is neither blank nor a comment */
+int is_data_line (span line){
     
-    /* get the file size at the end */
-    input_file_size = ftell(in_stream);
-    
-    /* get back to the beginning of file */
-    rewind(in_stream);
-    
-    /* return the chars in file */
-    return input_file_size;
+    line = span_trim (line);
     
+    return line.begin < line.end && *line.begin != '#';
 }
 
 /* A file to get the number of columns in a line                     */
 /* also, the max for even columns is stored in max_r if exceeding it */
-int get_ncolumns ( char *line, int *max_r) {
+int get_ncolumns (span line, int *max_r) {
     
     int n = 0, m;
-    char *colon = strchr(line, ':'), *r, *parse1 = line, *parse2;
+    const char *colon = span_find (line, ':');
+    span token;
     
     /* ignore whatever comes before the ":" */
-    if (colon != NULL) parse1 = colon + 1;
-    
-    /* remove trailing space */
-    while ( *parse1 == ' ') parse1++;
+    if (colon != NULL) line.begin = colon + 1;
     
     /* for all columns */
-    while ( strchr(parse1, ' ') != NULL ){
+    while ( span_next_token (&line, &token) ){
         
         /* if column even */
         if (n%2 == 0){
             
-            parse2 = strchr(parse1, ' ');
-            
             /* get the column value */
-            r = get_substring (parse1, parse2);
-            
-            /* turn it to int */
-            m = atoi( r );
+            m = (int) span_to_long (token);
             
             /* if greater than max_r, store it */
             if (m > *max_r) *max_r = m;
@@ -415,131 +269,9 @@ int get_ncolumns ( char *line, int *max_r) {
         
         /* increase the column counter */
         n++;
-        
-        /* get to next column */
-        parse1 = strchr(parse1, ' ') + 1;
-        
     }
     
     /* return the number of columns */
     return n;
     
 }
-
-/* A function that guessues the type of the input file and that stores its content in a file_wrapper struct */
-int guess_file_type (char *file_content, metabolite_parse **raw_metabs, int initial_n, int *n_metabs, int *n_reacs){
-    
-    char *s1 = file_content, *s2, *line;
-    int file_type0 = 0, file_type1 = 1, file_type2 = 0, n_columns0, n_columnsvar, max_react = -1, n_allowed = initial_n;
-    
-    int n_metabs0 = 0, n_metabs2 = 0, n_react0 = -1, n_react1= 0, n_react2 = 0;
-    
-    /* for all file lines */
-    while ( strchr(s1, '\n') != NULL ){
-        
-        /* get to the end of line */
-        s2 = strchr(s1, '\n');
-        
-        /* copy the line content */
-        line = get_substring (s1, s2);
-        
-        /* only evaluate if not a comment */
-        if ( *line != '#'){
-            
-            /* if the ">" sign in line, the file is probably a reaction list (i.e. featuring "-->")*/
-            if ( strchr(s1, '>') != NULL ){
-                
-                /* filetype 2, reaction list */
-                file_type2 = 1;
-                
-                /* parse the line as a reaction */
-                parse_react_line (line, &n_allowed, raw_metabs, &n_metabs2, n_react2);
-                
-                /* increase the number of reactions for filetype 2*/
-                n_react2 += 1;
-            }
-            
-            else{
-                
-                /* otherwise, it may either be a matrix, or an adjacency list */
-                if (s1 == file_content) {
-                    
-                    /* get the number of columns of the first line */
-                    n_columns0 = get_ncolumns (line, &max_react);
-                    
-                    /* if a matrix, the number of columns equals the number of reactions */
-                    n_react1 = n_columns0;
-                }
-                
-                /* get the number of columns for every line */
-                n_columnsvar = get_ncolumns (line, &n_react0);
-                
-                /* if the number of columns varies, then it cannot be a matrix */
-                if (n_columnsvar != n_columns0) file_type1 = 0;
-                
-                /* each line of the matrix or the adjacency list is a metabolite, increase the number of metabolites */
-                n_metabs0++;
-            }
-            
-        }
-        
-        /* get to the next line */
-        s1 = s2 + 1;
-    }
-    
-    /* if not a reaction list, nor a matrix, then assume it is an adjacency list */
-    if ( file_type1 == 0 && file_type2 == 0) {
-        
-        /* flag it is a filetype 0 */
-        file_type0 = 1;
-        
-        /* record the number of reactions according to the adjacency list standard */
-        *n_reacs = n_react0;
-        
-        /* record the number of metabolites according to the adjacency list standard */
-        *n_metabs = n_metabs0;
-        
-    }
-    
-    /* otherwise, if it cannot be a reaction list */
-    else if (file_type1 == 1 && file_type2 == 0){
-        
-        /* record the number of reactions according to the matrix standard */
-        *n_reacs = n_react1;
-        
-        /* record the number of metabolites according to the matrix standard */
-        *n_metabs = n_metabs0;
-        
-    }
-    
-    /* otherwise, if reaction list */
-    else if (file_type2 == 1 ){
-        
-        /* record the number of reactions according to the reaction list standard */
-        *n_reacs = n_react2;
-        
-        /* record the number of metabolites according to the reaction list standard */
-        *n_metabs = n_metabs2;
-        
-    }
-    
-    /* otherwise unknown */
-    else {
-        fprintf(stderr," UNKNWON INPUT FILE TYPE\n");
-        
-        exit (EXIT_FAILURE);
-    }
-    
-    /* return the filetype */
-    return file_type1 + file_type2;
-}
-
-
-
-
-
-
-
-
-
-
@@ -16,58 +16,53 @@
 #ifndef __PARSE_FILE_H__
 #define __PARSE_FILE_H__
 
+#include <stdint.h>
+
 #include "substring.h"
+#include "metabolites.h"
 
-/* a structure to store I/O metabolite/reactions adjacency lists*/
+/* an open addressing (linear probing) hash table over the names of the metabolites parsed so far */
+/* each new name gets the next metabolite index; the table and the names are taken from an arena */
 typedef struct{
     
-    /* number of reactions attached */
-    int n_react;
+    /* number of slots (a power of 2), and number of them in use, i.e. of metabolites */
+    int n_slots;
     
-    /* number of reactions that cab potentially be stored */
-    int n_allowed;
+    int n_used;
     
-    /* an array of pointers to the value of the reaction */
-    int *which_r;
+    /* the metabolite stored in each slot, -1 if the slot is empty */
+    int *slot;
     
-    /* an array of stoichiometric coefficients */
-    double *coeff;
+    /* the hash of the name in each slot, to compare strings only when hashes match */
+    uint32_t *hash;
     
-}adjacency_parse;
-
-/* a metabolite structure */
-typedef struct{
+    /* the null terminated name of each metabolite, and the number of metabolites allowed */
+    char **name;
     
-    /*metabolite name*/
-    char *name;
-    
-    /* input reactions*/
-    adjacency_parse input;
+    int n_allowed;
     
-    /*output reactions*/
-    adjacency_parse output;
-}metabolite_parse;
-
-void parser_free ( metabolite_parse **, int);
+    /* the arena everything is taken from: the table is freed with it */
+    arena *mem;
+}metabolite_index;
 
-metabolite_parse *find_metabolite (metabolite_parse *, int, char *);
+uint32_t name_hash (span);
 
-void append_new_met (char *, metabolite_parse **, int, int *);
+void metabolite_index_init (metabolite_index *, arena *, int);
 
-void update_io (adjacency_parse *, int, double);
+void metabolite_index_add (metabolite_index *, uint32_t, int);
 
-void update_metabolite (metabolite_parse *, int, double, int);
+int find_metabolite (metabolite_index *, span, uint32_t);
 
-void single_met_parse (char *, char *, int *, metabolite_parse **, int *, int, int);
+int append_new_met (metabolite_index *, span, uint32_t);
 
-void parse_subs_prods ( char *, int *, metabolite_parse **, int *, int, int);
+void single_met_parse (span, int, int, metabolite_index *, entry_list *);
 
-void parse_react_line (char *, int *, metabolite_parse **, int *, int);
+void parse_subs_prods (span, int, int, metabolite_index *, entry_list *);
 
-long get_file_size (FILE *);
+void parse_react_line (span, int, metabolite_index *, entry_list *);
 
-int get_ncolumns ( char *line, int *max_r);
+int is_data_line (span);
 
-int guess_file_type (char *, metabolite_parse **, int, int *, int *);
+int get_ncolumns (span, int *);
 
 #endif
@@ -0,0 +1,346 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "presolve.h"
+
+/* the hash of a reaction column, to bring identical columns next to each other */
+typedef struct{
+    
+    uint64_t hash;
+    
+    int j;
+}column_key;
+
+/* A function to sort the column keys by hash, and by reaction index within the same hash */
+static int compare_keys (const void *a, const void *b){
+    
+    const column_key *ka = (const column_key *) a, *kb = (const column_key *) b;
+    
+    if ( ka -> hash != kb -> hash ) return ka -> hash < kb -> hash ? -1 : 1;
+    
+    return ka -> j - kb -> j;
+}
+
+/* A function to hash the entries of column j that fall in the kept rows (new_row >= 0) */
+/* the number of such entries is stored in n_kept; the transpose of the network must be built */
+uint64_t column_hash (const network *net, int j, int *new_row, int *n_kept){
+    
+    int k;
+    
+    uint64_t h = 14695981039346656037ULL, bits;
+    
+    *n_kept = 0;
+    
+    for (k = *(net -> t_start + j); k < *(net -> t_start + j + 1); k++){
+        
+        if ( *(new_row + *(net -> t_row + k)) < 0 ) continue;
+        
+        /* mix the row and the bits of the coefficient, FNV-1a style */
+        memcpy (&bits, net -> t_coeff + k, sizeof (uint64_t) );
+        
+        h = (h ^ (uint64_t) *(new_row + *(net -> t_row + k)) ) * 1099511628211ULL;
+        
+        h = (h ^ bits) * 1099511628211ULL;
+        
+        *n_kept += 1;
+    }
+    
+    return h;
+}
+
+/* A function to check whether the columns a and b have the same entries in the kept rows */
+int same_column (const network *net, int a, int b, int *new_row){
+    
+    int ka = *(net -> t_start + a), kb = *(net -> t_start + b);
+    
+    while ( 1 ){
+        
+        /* skip the entries in the dropped rows */
+        while ( ka < *(net -> t_start + a + 1) && *(new_row + *(net -> t_row + ka)) < 0 ) ka++;
+        
+        while ( kb < *(net -> t_start + b + 1) && *(new_row + *(net -> t_row + kb)) < 0 ) kb++;
+        
+        /* both columns are over at the same time */
+        if ( ka == *(net -> t_start + a + 1) || kb == *(net -> t_start + b + 1) ) return ka == *(net -> t_start + a + 1) && kb == *(net -> t_start + b + 1);
+        
+        if ( *(net -> t_row + ka) != *(net -> t_row + kb) || *(net -> t_coeff + ka) != *(net -> t_coeff + kb) ) return 0;
+        
+        ka++;
+        
+        kb++;
+    }
+}
+
+/* A function to shrink the network before sampling, the way back to the original reactions is stored in map */
+/* metabolites that are only produced are dropped, since their constraint can never be binding; */
+/* reactions locked at zero are dropped, those locked at non-zero values are folded into a single pseudo reaction, */
+/* locked at 1, whose coefficients are the constant terms of the constraints; identical free reactions are merged */
+/* and, when no constant term is left, reactions that appear in no constraint are dropped (their flux is zero) */
+/* the locked reactions are replaced by those of the reduced network; 0 is returned if the network is left as it is */
+int presolve (network *net, presolve_map *map, int **s_locked, double **lock_v, int *n_locked, FILE *outfile){
+    
+    int i, j, k, l, n_keys = 0, n_rows = 0, n_groups = 0, n_empty = 0, n_folded = 0, pseudo = 0, n_kept;
+    
+    int *new_row, *rep, *dummy_i;
+    
+    double free_sum = (double) net -> Nreact, in_locked, out_locked, mu;
+    
+    char *is_locked = (char *) calloc (net -> Nreact, sizeof (char) );
+    
+    column_key *keys;
+    
+    network reduced;
+    
+    map -> Nreact = net -> Nreact;
+    
+    map -> column = (int *) malloc ( net -> Nreact * sizeof (int) );
+    
+    map -> fixed = (double *) calloc ( net -> Nreact, sizeof (double) );
+    
+    map -> n_merged = NULL;
+    
+    /* the locked reactions keep their value, and take it from the flux left to the free ones */
+    for (k = 0; k < *n_locked; k++){
+        
+        j = *(*s_locked + k);
+        
+        *(is_locked + j) = 1;
+        
+        *(map -> fixed + j) = *(*lock_v + k);
+        
+        free_sum -= *(*lock_v + k);
+        
+        if ( *(*lock_v + k) != 0. ) pseudo = 1;
+    }
+    
+    if ( pseudo && free_sum <= 0. ){
+        
+        fprintf(stderr, "The locked reactions leave no flux to the free ones, the network cannot be presolved\n");
+        
+        exit (EXIT_FAILURE);
+    }
+    
+    /* number the metabolites that are consumed, the others are dropped */
+    new_row = (int *) malloc ( (net -> Nmet > 0 ? net -> Nmet : 1) * sizeof (int) );
+    
+    for (i = 0; i < net -> Nmet; i++) *(new_row + i) = *(net -> split + i) > *(net -> row + i) ? n_rows++ : -1;
+    
+    /* hash the free columns, restricted to the kept rows, and sort them so that identical ones are adjacent */
+    network_transpose (net);
+    
+    keys = (column_key *) malloc ( (net -> Nreact > 0 ? net -> Nreact : 1) * sizeof (column_key) );
+    
+    rep = (int *) malloc ( (net -> Nreact > 0 ? net -> Nreact : 1) * sizeof (int) );
+    
+    for (j = 0; j < net -> Nreact; j++){
+        
+        /* each reaction stands for itself until merged */
+        *(rep + j) = j;
+        
+        if ( *(is_locked + j) ){
+            
+            *(map -> column + j) = -1;
+            
+            continue;
+        }
+        
+        (keys + n_keys) -> hash = column_hash (net, j, new_row, &n_kept);
+        
+        (keys + n_keys) -> j = j;
+        
+        n_keys++;
+        
+        /* flag the empty columns for now */
+        *(map -> column + j) = n_kept > 0 ? 0 : -2;
+    }
+    
+    qsort (keys, n_keys, sizeof (column_key), compare_keys);
+    
+    /* within each run of equal hashes, merge every column into the first identical one, i.e. the smallest index */
+    for (k = 0; k < n_keys; k = l){
+        
+        for (l = k + 1; l < n_keys && (keys + l) -> hash == (keys + k) -> hash; l++);
+        
+        for (i = k; i < l; i++){
+            
+            if ( *(rep + (keys + i) -> j) != (keys + i) -> j ) continue;
+            
+            for (j = i + 1; j < l; j++){
+                
+                if ( *(rep + (keys + j) -> j) == (keys + j) -> j && same_column (net, (keys + i) -> j, (keys + j) -> j, new_row) ) *(rep + (keys + j) -> j) = (keys + i) -> j;
+            }
+        }
+    }
+    
+    free (keys);
+    
+    /* number the reduced reactions in the original order */
+    for (j = 0; j < net -> Nreact; j++){
+        
+        if ( *(is_locked + j) ) n_folded += *(map -> fixed + j) != 0.;
+        
+        /* with no constant terms, a reaction out of every constraint can take no flux */
+        else if ( *(map -> column + j) == -2 && pseudo == 0 ){
+            
+            *(map -> column + j) = -1;
+            
+            n_empty++;
+        }
+        
+        else if ( *(rep + j) == j ) *(map -> column + j) = n_groups++;
+        
+        else *(map -> column + j) = *(map -> column + *(rep + j));
+    }
+    
+    /* nothing left to sample: keep the network as it is */
+    if ( n_groups == 0 ){
+        
+        fprintf(outfile, "Presolve leaves no free reaction, the network is kept as it is\n");
+        
+        network_free_transpose (net);
+        
+        free (new_row);
+        
+        free (rep);
+        
+        free (is_locked);
+        
+        presolve_free (map);
+        
+        return 0;
+    }
+    
+    /* count the original reactions behind each reduced one */
+    map -> n_merged = (int *) calloc ( n_groups + pseudo, sizeof (int) );
+    
+    for (dummy_i = map -> column; dummy_i < map -> column + net -> Nreact; dummy_i++) if ( *dummy_i >= 0 ) *(map -> n_merged + *dummy_i) += 1;
+    
+    /* the reduced free fluxes sum to n_groups, the original ones to free_sum: the constant terms are rescaled to match */
+    map -> scale = free_sum / (double) n_groups;
+    
+    mu = 1. / map -> scale;
+    
+    /* build the reduced network, row by row */
+    network_alloc (&reduced, n_rows, n_groups + pseudo, net -> nnz);
+    
+    for (i = 0; i < net -> Nmet; i++){
+        
+        if ( *(new_row + i) < 0 ) continue;
+        
+        in_locked = 0.;
+        
+        out_locked = 0.;
+        
+        /* the inputs of the representatives, and the constant input of the locked reactions */
+        for (k = *(net -> row + i); k < *(net -> split + i); k++){
+            
+            j = *(net -> col + k);
+            
+            if ( *(is_locked + j) ) in_locked += *(net -> coeff + k) * *(map -> fixed + j);
+            
+            else if ( *(rep + j) == j && *(map -> column + j) >= 0 ) network_add_entry (&reduced, *(map -> column + j), *(net -> coeff + k) );
+        }
+        
+        if ( in_locked != 0. ) network_add_entry (&reduced, n_groups, in_locked * mu);
+        
+        network_split_row (&reduced, *(new_row + i) );
+        
+        /* and the same for the outputs */
+        for (k = *(net -> split + i); k < *(net -> row + i + 1); k++){
+            
+            j = *(net -> col + k);
+            
+            if ( *(is_locked + j) ) out_locked += *(net -> coeff + k) * *(map -> fixed + j);
+            
+            else if ( *(rep + j) == j && *(map -> column + j) >= 0 ) network_add_entry (&reduced, *(map -> column + j), *(net -> coeff + k) );
+        }
+        
+        if ( out_locked != 0. ) network_add_entry (&reduced, n_groups, out_locked * mu);
+        
+        network_end_row (&reduced, *(new_row + i) );
+    }
+    
+    fprintf(outfile, "Presolve: %d of %d metabolites left (%d only produced), %d of %d reactions left (%d locked at zero, %d folded into constant terms, %d empty, %d merged)\n", n_rows, net -> Nmet, net -> Nmet - n_rows, n_groups + pseudo, net -> Nreact, *n_locked - n_folded, n_folded, n_empty, net -> Nreact - *n_locked - n_empty - n_groups);
+    
+    /* the reduced network takes the place of the original one */
+    network_free (net);
+    
+    *net = reduced;
+    
+    /* the only locked reaction left is the pseudo reaction of the constant terms */
+    free (*s_locked);
+    
+    free (*lock_v);
+    
+    *s_locked = NULL;
+    
+    *lock_v = NULL;
+    
+    *n_locked = pseudo;
+    
+    if ( pseudo ){
+        
+        *s_locked = (int *) malloc ( sizeof (int) );
+        
+        *lock_v = (double *) malloc ( sizeof (double) );
+        
+        **s_locked = n_groups;
+        
+        **lock_v = 1.;
+    }
+    
+    free (new_row);
+    
+    free (rep);
+    
+    free (is_locked);
+    
+    return 1;
+}
+
+/* A function to map the fluxes s_reduced of the presolved network back to the original reactions */
+/* merged reactions share the flux of their reduced reaction evenly, removed ones take their fixed value */
+void presolve_expand (const presolve_map *map, const double *s_reduced, double *s){
+    
+    int *dummy_c;
+    
+    double *dummy_s = s, *dummy_f = map -> fixed;
+    
+    for (dummy_c = map -> column; dummy_c < map -> column + map -> Nreact; dummy_c++){
+        
+        if ( *dummy_c >= 0 ) *dummy_s = map -> scale * *(s_reduced + *dummy_c) / (double) *(map -> n_merged + *dummy_c);
+        
+        else *dummy_s = *dummy_f;
+        
+        dummy_s++;
+        
+        dummy_f++;
+    }
+}
+
+void presolve_free (presolve_map *map){
+    
+    free (map -> column);
+    
+    free (map -> n_merged);
+    
+    free (map -> fixed);
+    
+    map -> column = NULL;
+    
+    map -> n_merged = NULL;
+    
+    map -> fixed = NULL;
+}
@@ -0,0 +1,55 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __PRESOLVE_H__
+#define __PRESOLVE_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "metabolites.h"
+
+/* the way back from the fluxes of a presolved network to those of the original one */
+typedef struct{
+    
+    /* the number of reactions of the original network */
+    int Nreact;
+    
+    /* the reduced reaction each original reaction is merged into, -1 if it was removed */
+    int *column;
+    
+    /* the number of original reactions merged into each reduced reaction */
+    int *n_merged;
+    
+    /* the value of each removed reaction: its lock value, or zero */
+    double *fixed;
+    
+    /* the factor taking the reduced free fluxes to the normalisation of the original network */
+    double scale;
+}presolve_map;
+
+uint64_t column_hash (const network *, int, int *, int *);
+
+int same_column (const network *, int, int, int *);
+
+int presolve (network *, presolve_map *, int **, double **, int *, FILE *);
+
+void presolve_expand (const presolve_map *, const double *, double *);
+
+void presolve_free (presolve_map *);
+
+#endif
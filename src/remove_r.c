@@ -13,30 +13,52 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+
 #include "remove_r.h"
 
-/* A function to 'remove' reactions from a metabolite i/o list */
-void remove_reaction(double **react_list, double **to_remove, int n_reacs, double *coeff_list){
-    
-    double *tmp, c_tmp;
-    
-    /* the reaction is not really removed, but pushed to the end of the array */
-    tmp = *to_remove;
-    
-    /* the array location to_remove will now point to reaction pointed by the last guy in the array **react_list */
-    *to_remove = *(react_list + n_reacs - 1);
+/* A function to remove the flagged reactions from the network */
+/* the entries of every row are compacted in place, keeping inputs before outputs */
+/* the number of entries removed is returned */
+int remove_reactions (network *net, char *is_null){
     
-    /* the last element of the array points to the reaction originally pointed by to_remove */
-    *(react_list + n_reacs - 1) = tmp;
+    int i, k, start, kept = 0, removed = net -> nnz;
     
-    /* stoichiometric coefficients must be swapped too */
-    c_tmp = *(coeff_list + (int)( to_remove - react_list) );
+    /* loop over the rows of the network */
+    for (i = 0; i < net -> Nmet; i++){
+        
+        /* the row begins where the compacted entries have arrived so far */
+        start = *(net -> row + i);
+        
+        *(net -> row + i) = kept;
+        
+        /* loop over the entries of row i */
+        for (k = start; k < *(net -> row + i + 1); k++){
+            
+            /* the outputs of the row begin here */
+            if ( k == *(net -> split + i) ) *(net -> split + i) = kept;
+            
+            /* if the reaction is null, drop the entry */
+            if ( *(is_null + *(net -> col + k)) ) continue;
+            
+            /* otherwise, shift it to the first free position */
+            *(net -> col + kept) = *(net -> col + k);
+            
+            *(net -> coeff + kept) = *(net -> coeff + k);
+            
+            kept++;
+        }
+        
+        /* if the row has no outputs left, the split is at its end */
+        if ( *(net -> split + i) > kept ) *(net -> split + i) = kept;
+    }
     
-    /* assign array element associated to to_remove to last array value */
-    *(coeff_list + (int)( to_remove - react_list) ) = *(coeff_list + n_reacs - 1 );
+    /* close the last row */
+    *(net -> row + net -> Nmet) = kept;
     
-    /* end swapping by associating to last array elemtnt the coefficient previously associated with to_remove*/
-    *(coeff_list + n_reacs - 1 ) = c_tmp;
+    net -> nnz = kept;
     
+    /* a transpose built before the removal is no longer valid */
+    if ( net -> t_start != NULL ) network_transpose (net);
     
+    return removed - kept;
 }
@@ -16,8 +16,11 @@
 #ifndef __REMOVE_R_H__
 #define __REMOVE_R_H__
 
+#include <stdio.h>
 #include <stdlib.h>
 
-void remove_reaction(double **, double **, int, double *);
+#include "metabolites.h"
+
+int remove_reactions (network *, char *);
 
 #endif
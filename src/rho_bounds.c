@@ -0,0 +1,235 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "rho_bounds.h"
+
+/* A function to get the largest rho satisfied by the fluxes s, i.e. the smallest output / input ratio over the metabolites */
+/* any s >= 0 gives a lower bound on the maximal rho (HUGE_VAL if no metabolite is consumed) */
+double rho_lower_bound (const network *net, double *s){
+    
+    int i, k;
+    double in, out, r = HUGE_VAL;
+    
+    for (i = 0; i < net -> Nmet; i++){
+        
+        /* inputs have negative coefficients */
+        for (in = 0., k = *(net -> row + i); k < *(net -> split + i); k++) in -= *(net -> coeff + k) * s[*(net -> col + k)];
+        
+        for (out = 0., k = *(net -> split + i); k < *(net -> row + i + 1); k++) out += *(net -> coeff + k) * s[*(net -> col + k)];
+        
+        if ( in > 0. && out / in < r ) r = out / in;
+    }
+    
+    return r;
+}
+
+/* A function to get an upper bound on the maximal rho from weights y >= 0 over the metabolites: summing the constraints */
+/* with weights y, every feasible s satisfies sum_j s_j (y_out_j - rho y_in_j) >= 0, so that rho <= max_j y_out_j / y_in_j */
+/* (HUGE_VAL if some reaction has no weighted input); y_in and y_out (Nreact) are scratch space */
+double rho_upper_bound (const network *net, double *y, char *excluded, double *y_in, double *y_out){
+    
+    int i, j, k;
+    double r = 0.;
+    
+    for (j = 0; j < net -> Nreact; j++){
+        
+        y_in[j] = 0.;
+        
+        y_out[j] = 0.;
+    }
+    
+    for (i = 0; i < net -> Nmet; i++){
+        
+        for (k = *(net -> row + i); k < *(net -> split + i); k++) y_in[*(net -> col + k)] -= y[i] * *(net -> coeff + k);
+        
+        for (k = *(net -> split + i); k < *(net -> row + i + 1); k++) y_out[*(net -> col + k)] += y[i] * *(net -> coeff + k);
+    }
+    
+    for (j = 0; j < net -> Nreact; j++){
+        
+        if ( excluded != NULL && *(excluded + j) ) continue;
+        
+        if ( !(y_in[j] > 0.) ) return HUGE_VAL;
+        
+        if ( y_out[j] / y_in[j] > r ) r = y_out[j] / y_in[j];
+    }
+    
+    return r;
+}
+
+/* A function to run a short relaxed minover at rho: n_sweeps cyclic sweeps over the metabolites, starting from the fluxes s */
+/* (zero on the reactions flagged in excluded), each violated constraint being over-fixed as it is met. The steps taken on */
+/* each metabolite add up in y, which (as for the perceptron) tends to a certificate of infeasibility when rho is too large */
+/* returns 1 if s satisfies rho, and 0 (with uniform fluxes in s) if the steps clip all the fluxes to zero */
+int relaxed_solve (const network *net, double rho, char *excluded, int n_sweeps, double *s, double *y){
+    
+    int i, j, k, sweep, n_updates = 1;
+    double c, g, g2, eta, sum;
+    
+    for (i = 0; i < net -> Nmet; i++) y[i] = 0.;
+    
+    for (sweep = 0; sweep < n_sweeps && n_updates > 0; sweep++){
+        
+        n_updates = 0;
+        
+        for (i = 0; i < net -> Nmet; i++){
+            
+            c = row_constraint (net, s, rho, i);
+            
+            if ( c >= 0. ) continue;
+            
+            /* the step fixing the constraint if no input is clipped, with a relaxation factor */
+            for (g2 = 0., k = *(net -> row + i); k < *(net -> row + i + 1); k++){
+                
+                if ( excluded != NULL && *(excluded + *(net -> col + k)) ) continue;
+                
+                g = *(net -> coeff + k) * ( k < *(net -> split + i) ? rho : 1. );
+                
+                g2 += g * g;
+            }
+            
+            if ( g2 == 0. ) continue;
+            
+            eta = - RHO_BOUNDS_RELAXATION * c / g2;
+            
+            for (k = *(net -> row + i); k < *(net -> row + i + 1); k++){
+                
+                j = *(net -> col + k);
+                
+                if ( excluded != NULL && *(excluded + j) ) continue;
+                
+                s[j] += *(net -> coeff + k) * ( k < *(net -> split + i) ? rho : 1. ) * eta;
+                
+                if ( s[j] < 0. ) s[j] = 0.;
+            }
+            
+            y[i] += eta;
+            
+            n_updates++;
+        }
+        
+        /* only the direction of s matters */
+        for (sum = 0., j = 0; j < net -> Nreact; j++) sum += s[j];
+        
+        /* all fluxes were clipped: no direction is left, and zero fluxes would satisfy any rho */
+        if ( !(sum > 0.) ){
+            
+            for (j = 0; j < net -> Nreact; j++) s[j] = ( excluded != NULL && *(excluded + j) ) ? 0. : 1. / net -> Nreact;
+            
+            return 0;
+        }
+        
+        for (j = 0; j < net -> Nreact; j++) s[j] /= sum;
+    }
+    
+    return n_updates == 0;
+}
+
+/* A function to bracket the maximal rho, lo <= rho <= hi, without solving the problem */
+/* the bounds of uniform fluxes and metabolite weights are refined by bisection: at each midpoint, a short relaxed solve */
+/* (n_sweeps sweeps from the fluxes of lo, see relaxed_solve) gives fluxes, that may raise lo, and weights, that may lower hi */
+/* a midpoint the solve fails on only bounds the next midpoints, since the failure proves nothing */
+/* the bounds are valid whatever the quality of the solves. Reactions flagged in excluded are kept at zero */
+void rho_bounds (const network *net, char *excluded, int n_sweeps, double *lo, double *hi){
+    
+    int j, n_solves = 0;
+    double rho, r, top;
+    
+    double *s = (double *) malloc( net -> Nreact * sizeof (double) );
+    
+    double *y = (double *) malloc( net -> Nmet * sizeof (double) );
+    
+    double *y_in = (double *) malloc( net -> Nreact * sizeof (double) );
+    
+    double *y_out = (double *) malloc( net -> Nreact * sizeof (double) );
+    
+    /* the fluxes of lo */
+    double *s_lo = (double *) malloc( net -> Nreact * sizeof (double) );
+    
+    for (j = 0; j < net -> Nreact; j++) s_lo[j] = ( excluded != NULL && *(excluded + j) ) ? 0. : 1. / net -> Nreact;
+    
+    for (j = 0; j < net -> Nmet; j++) y[j] = 1.;
+    
+    *lo = rho_lower_bound (net, s_lo);
+    
+    *hi = rho_upper_bound (net, y, excluded, y_in, y_out);
+    
+    /* the top of the bisection bracket */
+    top = *hi;
+    
+    while (top - *lo > RHO_BOUNDS_TOL * top && n_solves++ < RHO_BOUNDS_SOLVES){
+        
+        /* without an upper bound yet, look past lo */
+        rho = top < HUGE_VAL ? 0.5 * (*lo + top) : 2. * *lo + 1.;
+        
+        for (j = 0; j < net -> Nreact; j++) s[j] = s_lo[j];
+        
+        relaxed_solve (net, rho, excluded, n_sweeps, s, y);
+        
+        r = rho_lower_bound (net, s);
+        
+        if ( r > *lo ){
+            
+            *lo = r;
+            
+            for (j = 0; j < net -> Nreact; j++) s_lo[j] = s[j];
+        }
+        
+        r = rho_upper_bound (net, y, excluded, y_in, y_out);
+        
+        if ( r < *hi ) *hi = r;
+        
+        if ( *lo < rho ) top = rho;
+        
+        if ( *hi < top ) top = *hi;
+    }
+    
+    free (s);
+    
+    free (y);
+    
+    free (y_in);
+    
+    free (y_out);
+    
+    free (s_lo);
+}
+
+/* A function to bracket the maximal rho of a network with locked reactions (see rho_bounds): those locked at zero are */
+/* left out; returns 0 (and no bracket) if some reaction is locked at another value, which rho_bounds cannot handle */
+int rho_bracket (const network *net, int *locked, int n_locked, double *lock_value, double *lo, double *hi){
+    
+    int *s_d;
+    
+    char *excluded = (char *) calloc( net -> Nreact, sizeof (char) );
+    
+    for (s_d = locked; s_d < locked + n_locked; s_d++){
+        
+        if ( *(lock_value + (s_d - locked)) != 0. ){
+            
+            free (excluded);
+            
+            return 0;
+        }
+        
+        *(excluded + *s_d) = 1;
+    }
+    
+    rho_bounds (net, excluded, RHO_BOUNDS_SWEEPS, lo, hi);
+    
+    free (excluded);
+    
+    return 1;
+}
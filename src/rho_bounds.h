@@ -0,0 +1,43 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __RHO_BOUNDS_H__
+#define __RHO_BOUNDS_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "metabolites.h"
+#include "minover.h"
+
+/* the sweeps of each relaxed solve of rho_bounds, their relaxation factor, the number of solves */
+/* and the relative width of the bracket it stops at */
+#define RHO_BOUNDS_SWEEPS 1000
+#define RHO_BOUNDS_SOLVES 40
+#define RHO_BOUNDS_RELAXATION 1.9
+#define RHO_BOUNDS_TOL 1.e-3
+
+double rho_lower_bound (const network *, double *);
+
+double rho_upper_bound (const network *, double *, char *, double *, double *);
+
+int relaxed_solve (const network *, double, char *, int, double *, double *);
+
+void rho_bounds (const network *, char *, int, double *, double *);
+
+int rho_bracket (const network *, int *, int, double *, double *, double *);
+
+#endif
@@ -0,0 +1,104 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "rng.h"
+
+/* A function to rotate a 64 bit word */
+static inline uint64_t rotl (const uint64_t x, int k){
+    
+    return (x << k) | (x >> (64 - k));
+}
+
+/* A function to seed the generator: the state is filled by a splitmix64 sequence, so that it is never all zero */
+void rng_seed (rng_state *r, uint64_t seed){
+    
+    int i;
+    uint64_t z;
+    
+    for (i = 0; i < 4; i++){
+        
+        seed += 0x9e3779b97f4a7c15ULL;
+        
+        z = seed;
+        
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        
+        r -> s[i] = z ^ (z >> 31);
+    }
+}
+
+/* A function to get the next 64 random bits (xoshiro256**) */
+uint64_t rng_next (rng_state *r){
+    
+    const uint64_t result = rotl (r -> s[1] * 5, 7) * 9, t = r -> s[1] << 17;
+    
+    r -> s[2] ^= r -> s[0];
+    
+    r -> s[3] ^= r -> s[1];
+    
+    r -> s[1] ^= r -> s[2];
+    
+    r -> s[0] ^= r -> s[3];
+    
+    r -> s[2] ^= t;
+    
+    r -> s[3] = rotl (r -> s[3], 45);
+    
+    return result;
+}
+
+/* A function to get a uniform random number in [0, 1), with 53 random bits */
+double rng_uniform (rng_state *r){
+    
+    return (double) (rng_next (r) >> 11) * 0x1.0p-53;
+}
+
+/* A function to move the generator 2^128 steps ahead: successive jumps give non-overlapping streams */
+void rng_jump (rng_state *r){
+    
+    static const uint64_t jump[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+    
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    int i, b;
+    
+    for (i = 0; i < 4; i++){
+        
+        for (b = 0; b < 64; b++){
+            
+            if ( jump[i] & (UINT64_C(1) << b) ){
+                
+                s0 ^= r -> s[0];
+                
+                s1 ^= r -> s[1];
+                
+                s2 ^= r -> s[2];
+                
+                s3 ^= r -> s[3];
+            }
+            
+            rng_next (r);
+        }
+    }
+    
+    r -> s[0] = s0;
+    
+    r -> s[1] = s1;
+    
+    r -> s[2] = s2;
+    
+    r -> s[3] = s3;
+}
@@ -0,0 +1,37 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __RNG_H__
+#define __RNG_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/* the state of a xoshiro256** random number generator */
+typedef struct{
+    
+    uint64_t s[4];
+}rng_state;
+
+void rng_seed (rng_state *, uint64_t);
+
+uint64_t rng_next (rng_state *);
+
+double rng_uniform (rng_state *);
+
+void rng_jump (rng_state *);
+
+#endif
@@ -0,0 +1,199 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "schedule.h"
+
+/* A function to grow a step budget by factor, clamped so that repeated growth cannot overflow an int */
+int grow_budget (int max_step, double factor){
+    
+    double grown = max_step * factor;
+    
+    return grown < INT_MAX / 2 ? (int) grown : INT_MAX / 2;
+}
+
+/* A function to set up a controller of the given kind (see solver_options.h), going from rho_min to rho_max */
+void schedule_init (schedule_controller *ctrl, int kind, const network *net, double rho_min, double rho_max, double step_init, int max_step){
+    
+    ctrl -> rho = rho_min;
+    
+    ctrl -> rho_min = rho_min;
+    
+    ctrl -> rho_max = rho_max;
+    
+    ctrl -> step = step_init;
+    
+    /* the first solve starts from random fluxes: the step is larger */
+    ctrl -> eta_factor = 10.;
+    
+    ctrl -> max_step = max_step;
+    
+    ctrl -> n_accepted = 0;
+    
+    ctrl -> v_start = 0.;
+    
+    ctrl -> c = NULL;
+    
+    switch (kind){
+            
+        case VN_SCHEDULE_ADAPTIVE:
+            
+            ctrl -> accept = adaptive_accept;
+            
+            ctrl -> reject = adaptive_reject;
+            
+            ctrl -> c = (double *) malloc( net -> Nmet * sizeof (double) );
+            
+            break;
+            
+        case VN_SCHEDULE_CLASSIC:
+            
+            ctrl -> accept = classic_accept;
+            
+            ctrl -> reject = classic_reject;
+            
+            break;
+            
+        default:
+            
+            fprintf(stderr, "Unknown schedule controller %d\n", kind);
+            
+            exit (EXIT_FAILURE);
+    }
+}
+
+/* A function to record the fluxes minover starts from at the current rho */
+void schedule_start (schedule_controller *ctrl, const network *net, double *s){
+    
+    if ( ctrl -> c != NULL ) ctrl -> v_start = - total_violation (net, s, ctrl -> rho, ctrl -> c);
+}
+
+/* A function to move on after minover converged in n_step steps */
+void schedule_accepted (schedule_controller *ctrl, int n_step){
+    
+    ctrl -> accept (ctrl, n_step);
+    
+    ctrl -> n_accepted++;
+    
+    /* after the first solve, the fluxes only need small corrections */
+    if (ctrl -> rho == ctrl -> rho_min) ctrl -> eta_factor /= 15.;
+    
+    /* increase rho value */
+    ctrl -> rho += ctrl -> step;
+}
+
+/* A function to move on after minover did not converge: the fluxes are those it stopped at, the backup is not restored yet */
+void schedule_rejected (schedule_controller *ctrl, const network *net, flux_state *fs, int n_step){
+    
+    double v_end = 0.;
+    
+    /* the violation minover stopped at (the fluxes are discarded anyway, so they can be normalised here) */
+    if ( ctrl -> c != NULL ){
+        
+        normalise_fluxes (fs -> s, fs -> Nreact, fs -> locked, fs -> n_locked, fs -> lock_value);
+        
+        v_end = - total_violation (net, fs -> s, ctrl -> rho, ctrl -> c);
+    }
+    
+    /*decrease rho to last succesful value */
+    ctrl -> rho -= ctrl -> step;
+    
+    ctrl -> reject (ctrl, n_step, v_end);
+    
+    if (ctrl -> rho == ctrl -> rho_min) ctrl -> eta_factor /= 15.;
+    
+    /* and try a smaller increment */
+    ctrl -> rho += ctrl -> step;
+}
+
+/* A function to free the controller */
+void schedule_free (schedule_controller *ctrl){
+    
+    free (ctrl -> c);
+}
+
+/* the classic rules: if approaching non - convergence, reduce the step size */
+void classic_accept (schedule_controller *ctrl, int n_step){
+    
+    if ( n_step > 2 * ctrl -> max_step / 3) {
+        
+        ctrl -> step /= 1.2;
+        
+        /* decrease the eta factor */
+        ctrl -> eta_factor /= 1.1;
+        
+        ctrl -> max_step = grow_budget (ctrl -> max_step, 1.2);
+    }
+}
+
+/* the classic rules: on failure, reduce step and eta factor and allow more steps */
+void classic_reject (schedule_controller *ctrl, int n_step, double v_end){
+    
+    /* the classic rules do not look at the run */
+    (void) n_step;
+    
+    (void) v_end;
+    
+    /* decrease the step value */
+    ctrl -> step /= 1.5;
+    
+    /* decrease the eta factor */
+    ctrl -> eta_factor /= 1.2;
+    
+    ctrl -> max_step = grow_budget (ctrl -> max_step, 1.5);
+}
+
+/* the adaptive rules: the steps minover needs grow with the rho increment, so the increment is rescaled */
+/* to make the next run take about a quarter of the budget (by at most a factor 1.5 either way) */
+/* since the schedule stops before rho_max, the increment only goes half way to it, so that rho_max is approached */
+void adaptive_accept (schedule_controller *ctrl, int n_step){
+    
+    double factor;
+    
+    /* the first run starts from random fluxes and says nothing about the increment */
+    if ( ctrl -> n_accepted > 0 ){
+        
+        factor = 0.25 * ctrl -> max_step / (n_step > 0 ? n_step : 1);
+        
+        if ( factor > 1.5 ) factor = 1.5;
+        
+        if ( factor < 1. / 1.5 ) factor = 1. / 1.5;
+        
+        ctrl -> step *= factor;
+    }
+    
+    if ( ctrl -> rho + ctrl -> step >= ctrl -> rho_max ) ctrl -> step = 0.5 * (ctrl -> rho_max - ctrl -> rho);
+}
+
+/* the adaptive rules: if the violation was still shrinking when minover stopped, the budget was too small; */
+/* otherwise minover was stuck, either because rho is not feasible or because eta is too coarse */
+void adaptive_reject (schedule_controller *ctrl, int n_step, double v_end){
+    
+    /* only the violation matters here */
+    (void) n_step;
+    
+    if ( v_end < 0.5 * ctrl -> v_start ){
+        
+        ctrl -> step /= 1.5;
+        
+        ctrl -> max_step = grow_budget (ctrl -> max_step, 1.5);
+    }
+    
+    else {
+        
+        ctrl -> step /= 2.;
+        
+        ctrl -> eta_factor /= 1.2;
+    }
+}
@@ -0,0 +1,83 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SCHEDULE_H__
+#define __SCHEDULE_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "metabolites.h"
+#include "fluxes.h"
+#include "flux_state.h"
+#include "continuation.h"
+#include "solver_options.h"
+
+/* the controller of the rho schedule: after each minover run it sets the next rho, */
+/* the rho step, the eta factor and the step budget; accept and reject are the pluggable rules */
+typedef struct schedule_controller{
+    
+    /* the rho to try next, the first and the last one, and the current increment */
+    double rho;
+    
+    double rho_min;
+    
+    double rho_max;
+    
+    double step;
+    
+    /* eta is multiplied by this factor */
+    double eta_factor;
+    
+    /* the number of minover steps allowed at each rho */
+    int max_step;
+    
+    /* the number of rho values accepted so far */
+    int n_accepted;
+    
+    /* the total violation of the fluxes minover starts from, and the constraints used to compute it */
+    /* (only for the controllers that look at the violation, otherwise c is NULL) */
+    double v_start;
+    
+    double *c;
+    
+    /* the rules applied when minover converges, and when it does not (with the violation it stopped at) */
+    void (*accept) (struct schedule_controller *, int);
+    
+    void (*reject) (struct schedule_controller *, int, double);
+}schedule_controller;
+
+int grow_budget (int, double);
+
+void schedule_init (schedule_controller *, int, const network *, double, double, double, int);
+
+void schedule_start (schedule_controller *, const network *, double *);
+
+void schedule_accepted (schedule_controller *, int);
+
+void schedule_rejected (schedule_controller *, const network *, flux_state *, int);
+
+void schedule_free (schedule_controller *);
+
+void classic_accept (schedule_controller *, int);
+
+void classic_reject (schedule_controller *, int, double);
+
+void adaptive_accept (schedule_controller *, int);
+
+void adaptive_reject (schedule_controller *, int, double);
+
+#endif
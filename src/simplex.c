@@ -0,0 +1,296 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "simplex.h"
+
+/* A function to solve exactly, by a dense simplex, the linear program behind a given rho: */
+/* find v = max min_i (s (a - rho b))_i over the fluxes s >= 0 with sum s = 1 (reactions flagged in excluded stay at 0) */
+/* this is the value of a matrix game: with B = (a - rho b) + K, K making all entries positive, the metabolites' strategy y solves */
+/*     max sum y    subject to    (y B)_j <= 1 for every reaction j,  y >= 0 */
+/* whose slack basis is feasible, so no first phase is needed. Then v = 1 / sum y - K, the fluxes are read off the reduced costs */
+/* of the slacks, and y / sum y is a probability over metabolites with (y (a - rho b))_j <= v for all j: if v < 0, */
+/* it certifies that no fluxes satisfy rho (Farkas). s (Nreact) and y (Nmet, if not NULL) are filled with the optimal ones */
+/* shift (Nmet, if not NULL) is added to every payoff of a metabolite, i.e. min_i (s (a - rho b))_i + shift_i is maximised */
+/* NAN is returned (and s, y are left as they are) if the tableau cannot be allocated or the pivots do not converge */
+double lp_max_min (const network *net, double rho, char *excluded, double *shift, double *s, double *y){
+    
+    int i, j, k, r, n = 0, m = net -> Nmet, w, e, l, n_pivot = 0, degenerate = 0;
+    double a, a_min = 0., K, ratio, best, f, z_val, *t, *z, *row, *dummy, *dummy_p;
+    
+    /* the row of each reaction in the tableau (-1 if excluded) */
+    int *t_row = (int *) malloc( net -> Nreact * sizeof (int) );
+    
+    for (j = 0; j < net -> Nreact; j++) *(t_row + j) = ( excluded != NULL && *(excluded + j) ) ? -1 : n++;
+    
+    /* a row per reaction: the metabolites' strategy, the slacks and the right hand side */
+    w = m + n + 1;
+    
+    t = (double *) calloc( (size_t) n * w, sizeof (double) );
+    
+    z = (double *) calloc( w, sizeof (double) );
+    
+    int *basis = (int *) malloc( (n > 0 ? n : 1) * sizeof (int) );
+    
+    if ( t == NULL || z == NULL ){
+        
+        free (t_row);
+        
+        free (t);
+        
+        free (z);
+        
+        free (basis);
+        
+        return NAN;
+    }
+    
+    /* fill in the transpose of a - rho b */
+    for (i = 0; i < m; i++){
+        
+        for (k = *(net -> row + i); k < *(net -> row + i + 1); k++){
+            
+            r = *(t_row + *(net -> col + k));
+            
+            if ( r < 0 ) continue;
+            
+            a = *(net -> coeff + k) * ( k < *(net -> split + i) ? rho : 1. );
+            
+            *(t + (size_t) r * w + i) += a;
+        }
+        
+        /* the constant term of the metabolite goes to each reaction, whose fluxes sum up to 1 */
+        if ( shift != NULL ) for (r = 0; r < n; r++) *(t + (size_t) r * w + i) += *(shift + i);
+    }
+    
+    for (dummy = t; dummy < t + (size_t) n * w; dummy++) if ( *dummy < a_min ) a_min = *dummy;
+    
+    /* shift all payoffs to be at least 1 */
+    K = 1. - a_min;
+    
+    for (r = 0; r < n; r++){
+        
+        row = t + (size_t) r * w;
+        
+        for (dummy = row; dummy < row + m; dummy++) *dummy += K;
+        
+        *(row + m + r) = 1.;
+        
+        *(row + w - 1) = 1.;
+        
+        *(basis + r) = m + r;
+    }
+    
+    /* the reduced costs of the objective, sum y */
+    for (dummy = z; dummy < z + m; dummy++) *dummy = -1.;
+    
+    while (1){
+        
+        /* the entering column: the most negative reduced cost, or the first negative one (Bland) when the pivots stall */
+        e = -1;
+        
+        best = -LP_EPS;
+        
+        for (i = 0; i < w - 1; i++){
+            
+            if ( *(z + i) < best ){
+                
+                e = i;
+                
+                if ( degenerate > 50 ) break;
+                
+                best = *(z + i);
+            }
+        }
+        
+        /* optimal */
+        if ( e < 0 ) break;
+        
+        /* the leaving row: the ratio test, ties broken by the smallest basic variable */
+        l = -1;
+        
+        best = HUGE_VAL;
+        
+        for (r = 0; r < n; r++){
+            
+            row = t + (size_t) r * w;
+            
+            if ( *(row + e) <= LP_EPS ) continue;
+            
+            ratio = *(row + w - 1) / *(row + e);
+            
+            if ( ratio < best || (l >= 0 && ratio == best && *(basis + r) < *(basis + l)) ){
+                
+                best = ratio;
+                
+                l = r;
+            }
+        }
+        
+        /* all payoffs are positive: the program is bounded, so only round-off or cycling get here */
+        if ( l < 0 || ++n_pivot > 50 * (m + n) ){
+            
+            free (t_row);
+            
+            free (t);
+            
+            free (z);
+            
+            free (basis);
+            
+            return NAN;
+        }
+        
+        degenerate = best == 0. ? degenerate + 1 : 0;
+        
+        /* pivot on (l, e) */
+        row = t + (size_t) l * w;
+        
+        f = 1. / *(row + e);
+        
+        for (dummy = row; dummy < row + w; dummy++) *dummy *= f;
+        
+        for (r = 0; r < n; r++){
+            
+            if ( r == l ) continue;
+            
+            f = *(t + (size_t) r * w + e);
+            
+            if ( f == 0. ) continue;
+            
+            for (dummy = t + (size_t) r * w, dummy_p = row; dummy_p < row + w; dummy++, dummy_p++) *dummy -= f * *dummy_p;
+        }
+        
+        f = *(z + e);
+        
+        for (dummy = z, dummy_p = row; dummy_p < row + w; dummy++, dummy_p++) *dummy -= f * *dummy_p;
+        
+        *(basis + l) = e;
+    }
+    
+    /* the optimal sum y, i.e. 1 / (v + K) */
+    z_val = *(z + w - 1);
+    
+    /* the fluxes are the duals of the reaction constraints */
+    for (j = 0; j < net -> Nreact; j++) s[j] = *(t_row + j) < 0 ? 0. : *(z + m + *(t_row + j)) / z_val;
+    
+    /* and the certificate the basic strategies */
+    if ( y != NULL ){
+        
+        for (i = 0; i < m; i++) y[i] = 0.;
+        
+        for (r = 0; r < n; r++) if ( *(basis + r) < m ) y[*(basis + r)] = *(t + (size_t) r * w + w - 1) / z_val;
+    }
+    
+    free (t_row);
+    
+    free (t);
+    
+    free (z);
+    
+    free (basis);
+    
+    return 1. / z_val - K;
+}
+
+/* A function to get the number of doubles in the tableau of lp_max_min (see LP_MAX_TABLEAU) */
+double lp_tableau_size (const network *net){
+    
+    return (double) net -> Nreact * (net -> Nmet + net -> Nreact + 1);
+}
+
+/* A function to check exactly whether rho is feasible for the reactions of a solve: returns 1 if so, 0 if not, and -1 */
+/* if the simplex failed. The fluxes (normalised as in normalise_fluxes) and the certificate (see lp_max_min) go to s and y, */
+/* unless NULL or the simplex failed. The locked reactions are substituted: their fluxes are constant terms of the */
+/* constraints, spread over the free fluxes, which sum up to what the locked ones leave */
+int lp_feasible (const network *net, flux_state *fs, double rho, double *s, double *y){
+    
+    int i, k, n_fixed = 0, *s_d;
+    double v, lock, free_sum = (double) net -> Nreact, *dummy, *shift = NULL;
+    
+    char *excluded = (char *) calloc( net -> Nreact, sizeof (char) );
+    
+    double *s_lp = (double *) malloc( net -> Nreact * sizeof (double) );
+    
+    /* the value of each reaction, zero unless locked */
+    double *fixed = (double *) calloc( net -> Nreact, sizeof (double) );
+    
+    for (s_d = fs -> locked; s_d < fs -> locked + fs -> n_locked; s_d++){
+        
+        lock = *(fs -> lock_value + (s_d - fs -> locked));
+        
+        *(excluded + *s_d) = 1;
+        
+        *(fixed + *s_d) = lock;
+        
+        free_sum -= lock;
+        
+        n_fixed += lock != 0.;
+    }
+    
+    if ( n_fixed > 0 ){
+        
+        /* no flux is left to the free reactions: the game has no strategy for them */
+        if ( free_sum <= 0. ){
+            
+            free (fixed);
+            
+            free (s_lp);
+            
+            free (excluded);
+            
+            return -1;
+        }
+        
+        shift = (double *) calloc( net -> Nmet, sizeof (double) );
+        
+        /* the payoffs of the locked reactions, per unit of free flux */
+        for (i = 0; i < net -> Nmet; i++){
+            
+            for (k = *(net -> row + i); k < *(net -> row + i + 1); k++){
+                
+                *(shift + i) += *(net -> coeff + k) * ( k < *(net -> split + i) ? rho : 1. ) * *(fixed + *(net -> col + k)) / free_sum;
+            }
+        }
+    }
+    
+    v = lp_max_min (net, rho, excluded, shift, s_lp, y);
+    
+    free (shift);
+    
+    free (fixed);
+    
+    free (excluded);
+    
+    if ( isnan (v) ){
+        
+        free (s_lp);
+        
+        return -1;
+    }
+    
+    if ( s != NULL ){
+        
+        /* the free fluxes sum up to what the locked ones leave of the number of reactions (round-off may leave them below zero) */
+        for (dummy = s_lp; dummy < s_lp + net -> Nreact; dummy++) *dummy = *dummy > 0. ? *dummy * free_sum : 0.;
+        
+        for (s_d = fs -> locked; s_d < fs -> locked + fs -> n_locked; s_d++) *(s_lp + *s_d) = *(fs -> lock_value + (s_d - fs -> locked));
+        
+        memcpy (s, s_lp, net -> Nreact * sizeof (double) );
+    }
+    
+    free (s_lp);
+    
+    return v >= -LP_TOL;
+}
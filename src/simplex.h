@@ -0,0 +1,40 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SIMPLEX_H__
+#define __SIMPLEX_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+#include "metabolites.h"
+#include "flux_state.h"
+
+/* the tolerance of the simplex pivots, and of the sign of the min constraint */
+#define LP_EPS 1.e-11
+#define LP_TOL 1.e-9
+
+/* the largest tableau the dense simplex is used on (in doubles, i.e. 200 MB): each pivot touches all of it */
+#define LP_MAX_TABLEAU 2.5e7
+
+double lp_max_min (const network *, double, char *, double *, double *, double *);
+
+double lp_tableau_size (const network *);
+
+int lp_feasible (const network *, flux_state *, double, double *, double *);
+
+#endif
@@ -0,0 +1,70 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "solver_options.h"
+
+/* A function to set the default options, i.e. the plain minover algorithm */
+void solver_options_init (solver_options *opt){
+    
+    opt -> incremental = 0;
+    
+    opt -> n_threads = 1;
+    
+    opt -> min_rows_per_thread = 2048;
+    
+    opt -> search = VN_SEARCH_SCHEDULE;
+    
+    opt -> search_workers = 1;
+    
+    opt -> exact = 0;
+    
+    opt -> continuation = 0;
+    
+    opt -> selection = VN_SELECT_ARGMIN;
+    
+    opt -> block_size = 1;
+    
+    opt -> damping = 1.;
+    
+    opt -> momentum = 0.;
+    
+    opt -> nesterov = 0;
+    
+    opt -> update = VN_UPDATE_FIXED;
+    
+    opt -> relaxation = 1.;
+    
+    opt -> schedule = VN_SCHEDULE_CLASSIC;
+    
+    opt -> stall_window = 0;
+    
+    opt -> stall_patience = 3;
+}
+
+/* A function to get the number of threads scanning a network with n_rows metabolites */
+int solver_threads (solver_options *opt, int n_rows){
+    
+    int n;
+    
+    if ( opt == NULL || opt -> n_threads <= 1 ) return 1;
+    
+    /* small networks stay on one core */
+    n = opt -> min_rows_per_thread > 0 ? n_rows / opt -> min_rows_per_thread : opt -> n_threads;
+    
+    if ( n < 1 ) n = 1;
+    
+    return n < opt -> n_threads ? n : opt -> n_threads;
+}
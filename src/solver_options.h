@@ -0,0 +1,100 @@
+/* vonNeumann, a minOver sampler of solutions to a von Neumann problem
+*
+* Copyright (C) 2015 Francesco A. Massucci
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef __SOLVER_OPTIONS_H__
+#define __SOLVER_OPTIONS_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* the strategies searching the maximal rho */
+#define VN_SEARCH_SCHEDULE 0
+#define VN_SEARCH_BISECTION 1
+#define VN_SEARCH_KSECTION 2
+
+/* the minover update rules */
+#define VN_UPDATE_FIXED 0
+#define VN_UPDATE_EXACT 1
+
+/* how minover picks the constraint to fix */
+#define VN_SELECT_ARGMIN 0
+#define VN_SELECT_CYCLIC 1
+#define VN_SELECT_RANDOM 2
+
+/* the controllers of the rho schedule (see schedule.h) */
+#define VN_SCHEDULE_CLASSIC 0
+#define VN_SCHEDULE_ADAPTIVE 1
+
+/* a structure collecting the optional features of the solver */
+typedef struct{
+    
+    /* if 1, minover caches the constraints and keeps the most violated one in a heap */
+    int incremental;
+    
+    /* the number of threads scanning the constraints in the plain minover */
+    int n_threads;
+    
+    /* networks with fewer metabolites per thread are scanned with fewer threads */
+    int min_rows_per_thread;
+    
+    /* how optimal_flux searches the maximal rho: the additive schedule, or bisection (k-section) down to step_min */
+    int search;
+    
+    /* if 1, the bisection asks the exact (simplex) engine about each rho before running minover on it */
+    int exact;
+    
+    /* the number of rho values tested at the same time by the k-section search */
+    int search_workers;
+    
+    /* the number of accepted (rho, fluxes) pairs the schedule extrapolates from before each minover, 0 to disable */
+    int continuation;
+    
+    /* the constraint minover fixes at each step: the most violated one, or the violated ones met by sweeps over the rows */
+    /* in their order or in a random one */
+    int selection;
+    
+    /* the number of most violated constraints the plain minover fixes together at each step, from one scan (0 for all the violated ones) */
+    int block_size;
+    
+    /* the steps of a block are multiplied by this factor */
+    double damping;
+    
+    /* the momentum of the plain and block minover: each step adds momentum times the previous one (0 for none), */
+    /* in the heavy ball or in the Nesterov form */
+    double momentum;
+    
+    int nesterov;
+    
+    /* the minover update: a fixed step eta, or the step that exactly fixes the violated constraint */
+    int update;
+    
+    /* the exact step is multiplied by this factor (1 stops at the constraint, larger values overshoot into the feasible side) */
+    double relaxation;
+    
+    /* the controller setting the rho step, eta and the step budget of the schedule */
+    int schedule;
+    
+    /* minover gives up when the worst violation has not shrunk over stall_patience windows of stall_window steps (0 never gives up) */
+    int stall_window;
+    
+    int stall_patience;
+}solver_options;
+
+void solver_options_init (solver_options *);
+
+int solver_threads (solver_options *, int);
+
+#endif
@@ -48,3 +48,236 @@ char *get_substring_no_copy (char *full_string, char *cutoff){
 
     return full_string;
 }
+
+/* the powers of 10 that are exact in double precision */
+static const double exact_pow10[23] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/* A function to make a span of the characters in [begin, end) */
+span span_of (const char *begin, const char *end){
+    
+    span s;
+    
+    s.begin = begin;
+    
+    s.end = end;
+    
+    return s;
+}
+
+/* A function to cut the next line (without its "\n", nor a "\r" before it) off the front of rest */
+/* 0 is returned when rest is over */
+int span_next_line (span *rest, span *line){
+    
+    const char *eol;
+    
+    if ( rest -> begin >= rest -> end ) return 0;
+    
+    eol = (const char *) memchr (rest -> begin, '\n', rest -> end - rest -> begin);
+    
+    /* the last line may lack its "\n" */
+    if ( eol == NULL ) eol = rest -> end;
+    
+    *line = span_of (rest -> begin, eol);
+    
+    if ( line -> end > line -> begin && *(line -> end - 1) == '\r' ) line -> end--;
+    
+    rest -> begin = eol < rest -> end ? eol + 1 : eol;
+    
+    return 1;
+}
+
+/* A function to cut the next blank separated token off the front of rest, 0 is returned when there is none */
+int span_next_token (span *rest, span *token){
+    
+    const char *c = rest -> begin;
+    
+    /* skip the blanks */
+    while ( c < rest -> end && (*c == ' ' || *c == '\t' || *c == '\r') ) c++;
+    
+    if ( c == rest -> end ){
+        
+        rest -> begin = c;
+        
+        return 0;
+    }
+    
+    token -> begin = c;
+    
+    while ( c < rest -> end && *c != ' ' && *c != '\t' && *c != '\r' ) c++;
+    
+    token -> end = c;
+    
+    rest -> begin = c;
+    
+    return 1;
+}
+
+/* A function to cut the piece before the next separator sep off the front of rest (the whole rest if there is no sep) */
+/* 0 is returned once the last piece has been cut */
+int span_split (span *rest, char sep, span *piece){
+    
+    const char *c;
+    
+    if ( rest -> begin == NULL ) return 0;
+    
+    c = (const char *) memchr (rest -> begin, sep, rest -> end - rest -> begin);
+    
+    if ( c != NULL ){
+        
+        *piece = span_of (rest -> begin, c);
+        
+        rest -> begin = c + 1;
+    }
+    
+    /* the last piece: mark rest as over */
+    else{
+        
+        *piece = *rest;
+        
+        rest -> begin = NULL;
+        
+        rest -> end = NULL;
+    }
+    
+    return 1;
+}
+
+/* A function to drop the blanks at both ends of s */
+span span_trim (span s){
+    
+    while ( s.begin < s.end && (*s.begin == ' ' || *s.begin == '\t' || *s.begin == '\r') ) s.begin++;
+    
+    while ( s.end > s.begin && (*(s.end - 1) == ' ' || *(s.end - 1) == '\t' || *(s.end - 1) == '\r') ) s.end--;
+    
+    return s;
+}
+
+/* A function to find the first c in s, NULL if there is none */
+const char *span_find (span s, char c){
+    
+    return (const char *) memchr (s.begin, c, s.end - s.begin);
+}
+
+/* A function to check whether s holds the null terminated string str */
+int span_equal (span s, const char *str){
+    
+    size_t n = s.end - s.begin;
+    
+    return strncmp (s.begin, str, n) == 0 && *(str + n) == '\0';
+}
+
+/* A function to read a decimal number at the front of s, the way atof does, but independently of the locale */
+/* up to 19 significant digits and a power of 10 up to 22 are converted exactly (and so correctly rounded), */
+/* anything else (e.g. longer mantissas, inf or nan) is handed to strtod */
+double span_to_double (span s){
+    
+    const char *c = s.begin;
+    
+    uint64_t m = 0;
+    
+    int negative = 0, n_digits = 0, n_significant = 0, exp10 = 0, e = 0, e_negative = 0;
+    
+    char buffer[64];
+    
+    size_t n;
+    
+    while ( c < s.end && (*c == ' ' || *c == '\t') ) c++;
+    
+    if ( c < s.end && (*c == '-' || *c == '+') ){
+        
+        negative = *c == '-';
+        
+        c++;
+    }
+    
+    /* the integer part: leading zeros are not significant, digits beyond the 19th only shift the exponent */
+    for (; c < s.end && *c >= '0' && *c <= '9'; c++, n_digits++){
+        
+        if ( n_significant < 19 ){
+            
+            m = 10 * m + (uint64_t) (*c - '0');
+            
+            if ( m > 0 ) n_significant++;
+        }
+        
+        else exp10++;
+    }
+    
+    /* the fractional part */
+    if ( c < s.end && *c == '.' ){
+        
+        for (c++; c < s.end && *c >= '0' && *c <= '9'; c++, n_digits++){
+            
+            if ( n_significant < 19 ){
+                
+                m = 10 * m + (uint64_t) (*c - '0');
+                
+                exp10--;
+                
+                if ( m > 0 ) n_significant++;
+            }
+        }
+    }
+    
+    /* the exponent, only if some digit follows the "e" */
+    if ( n_digits > 0 && c + 1 < s.end && (*c == 'e' || *c == 'E') ){
+        
+        const char *d = c + 1;
+        
+        if ( *d == '-' || *d == '+' ){
+            
+            e_negative = *d == '-';
+            
+            d++;
+        }
+        
+        if ( d < s.end && *d >= '0' && *d <= '9' ){
+            
+            for (; d < s.end && *d >= '0' && *d <= '9'; d++) if ( e < 100000 ) e = 10 * e + (*d - '0');
+            
+            exp10 += e_negative ? -e : e;
+        }
+    }
+    
+    /* the fast path: both the mantissa and the power of 10 are exact */
+    if ( n_digits > 0 && m <= (UINT64_C(1) << 53) && exp10 >= -22 && exp10 <= 22 ){
+        
+        double v = (double) m;
+        
+        v = exp10 < 0 ? v / exact_pow10[-exp10] : v * exact_pow10[exp10];
+        
+        return negative ? -v : v;
+    }
+    
+    /* otherwise, copy the token and let strtod round it */
+    n = s.end - s.begin < (long) sizeof (buffer) - 1 ? (size_t) (s.end - s.begin) : sizeof (buffer) - 1;
+    
+    memcpy (buffer, s.begin, n);
+    
+    buffer[n] = '\0';
+    
+    return strtod (buffer, NULL);
+}
+
+/* A function to read an integer at the front of s, the way atol does */
+long span_to_long (span s){
+    
+    const char *c = s.begin;
+    
+    long v = 0;
+    
+    int negative = 0;
+    
+    while ( c < s.end && (*c == ' ' || *c == '\t') ) c++;
+    
+    if ( c < s.end && (*c == '-' || *c == '+') ){
+        
+        negative = *c == '-';
+        
+        c++;
+    }
+    
+    for (; c < s.end && *c >= '0' && *c <= '9'; c++) v = 10 * v + (*c - '0');
+    
+    return negative ? -v : v;
+}
@@ -19,8 +19,36 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+
+/* a piece of a string, read in place and not null terminated: the characters in [begin, end) */
+typedef struct{
+    
+    const char *begin;
+    
+    const char *end;
+}span;
 
 char *get_substring (char *, char *);
 
 char *get_substring_no_copy (char *, char *);
+
+span span_of (const char *, const char *);
+
+int span_next_line (span *, span *);
+
+int span_next_token (span *, span *);
+
+int span_split (span *, char, span *);
+
+span span_trim (span);
+
+const char *span_find (span, char);
+
+int span_equal (span, const char *);
+
+double span_to_double (span);
+
+long span_to_long (span);
+
 #endif
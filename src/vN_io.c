@@ -13,227 +13,145 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+
 #include "vN_io.h"
 
-void print_matrix (metabolite *metabs, int Nmet, double *s, int Nreac, FILE *outfile){
+void print_matrix (network *net, FILE *outfile){
     
-    metabolite *dummy;
-    double *dummy_s0, **dummy_s, *c;
-    int done;
+    double *row_values = (double *) calloc (net -> Nreact, sizeof (double) ), *dummy_v;
+    int i, k;
     
-    for ( dummy = metabs; dummy < metabs + Nmet; dummy ++){
+    for ( i = 0; i < net -> Nmet; i++){
         
-        fprintf(outfile, "%d: ", (int)(dummy - metabs) + 1);
+        fprintf(outfile, "%d: ", i + 1);
         
-        for ( dummy_s0 = s; dummy_s0 < s + Nreac; dummy_s0++){
-            
-            done = 0;
-            
-            c = dummy -> input.coeff;
-            
-            for( dummy_s = dummy -> input.react; dummy_s < dummy -> input.react + dummy -> input.n_react; dummy_s++){
-                
-                if ( *dummy_s == dummy_s0) {
-                    
-                    fprintf(outfile, "%g ", -(*c) );
-                    
-                    done = 1;
-                }
-                
-                c++;
-            }
+        /* scatter the row into a dense array */
+        for ( k = *(net -> row + i); k < *(net -> row + i + 1); k++) *(row_values + *(net -> col + k)) += *(net -> coeff + k);
+        
+        /* print it and clean it for the next row */
+        for ( dummy_v = row_values; dummy_v < row_values + net -> Nreact; dummy_v++){
             
-            c = dummy -> output.coeff;
+            fprintf(outfile, "%g ", *dummy_v);
             
-            for( dummy_s = dummy -> output.react; dummy_s < dummy -> output.react + dummy -> output.n_react; dummy_s++){
-                
-                if ( *dummy_s == dummy_s0) {
-                    
-                    fprintf(outfile, "%g ", (*c) );
-                    
-                    done = 1;
-                }
-                
-                c++;
-            }
-            
-            if (done == 0) fprintf(outfile, "0 ");
+            *dummy_v = 0.;
         }
         
         fprintf(outfile, "\n");
     }
     
+    free (row_values);
 }
 
 /* A function to re-print the adjacency list of the system, mainly for debug purposes */
-void print_adj_list (metabolite *metabs, int Nmet, double *s, FILE *outfile){
+void print_adj_list (network *net, FILE *outfile){
     
-    metabolite *dummy;
-    double **s_dummy, *coeff;
+    int i, k;
     
-    /* Loop over emtabolites */
-    for (dummy = metabs; dummy < metabs + Nmet; dummy++){
+    /* Loop over metabolites */
+    for (i = 0; i < net -> Nmet; i++){
 
-        fprintf(outfile, "%d: ", (int)(dummy - metabs) + 1);
-        
-        /* initialise coeff to the first element of input.coeff array */
-        coeff = dummy -> input.coeff;
-        
-        /* loop over input reactions */
-        for (s_dummy = dummy -> input.react; s_dummy < dummy -> input.react + dummy -> input.n_react; s_dummy++){
-            
-            /* print reaction index & coefficient */
-            fprintf(outfile, "%d %g ", (int) (*s_dummy - s) + 1, -(*coeff));
-            
-            /* iterate the coefficient along the input.coeff array */
-            coeff++;
-        }
-        
+        fprintf(outfile, "%d: ", i + 1);
         
-        /* initialise coeff to the first element of output.coeff array */
-        coeff = dummy -> output.coeff;
-        
-        /* loop over output reactions */
-        for (s_dummy = dummy -> output.react; s_dummy < dummy -> output.react + dummy -> output.n_react; s_dummy++){
-            
-            /* print reaction index & coefficient */
-            fprintf(outfile, "%d %g ", (int) (*s_dummy - s) + 1, *coeff);
-            
-            /* iterate the coefficient along the output.coeff array */
-            coeff++;
-        }
+        /* loop over input and then output reactions: print reaction index & signed coefficient */
+        for (k = *(net -> row + i); k < *(net -> row + i + 1); k++) fprintf(outfile, "%d %g ", *(net -> col + k) + 1, *(net -> coeff + k));
         
         fprintf(outfile, "\n");
     }
 }
 
 /* A function to re-print the system, mainly for debug purposes */
-void print_system (metabolite *metabs, int Nmet, double *s, FILE *outfile){
+void print_system (network *net, FILE *outfile){
     
-    metabolite *dummy;
-    double **s_dummy, *coeff;
+    int i, k;
     
-    /* Loop over emtabolites */
-    for (dummy = metabs; dummy < metabs + Nmet; dummy++){
+    /* Loop over metabolites */
+    for (i = 0; i < net -> Nmet; i++){
         
-        fprintf(outfile, "Metabolite %d enters:\n", (int)(dummy - metabs) + 1);
+        fprintf(outfile, "Metabolite %d enters:\n", i + 1);
         
-        fprintf(outfile, "As input in %d reactions:\n", dummy -> input.n_react);
-        
-        /* initialise coeff to the first element of input.coeff array */
-        coeff = dummy -> input.coeff;
-        
-        /* loop over input reactions */
-        for (s_dummy = dummy -> input.react; s_dummy < dummy -> input.react + dummy -> input.n_react; s_dummy++){
-            
-            /* print reaction index & coefficient */
-            fprintf(outfile, "\t %d with coefficient %g\n", (int) (*s_dummy - s) + 1, *coeff);
-            
-            /* iterate the coefficient along the input.coeff array */
-            coeff++;
-        }
+        fprintf(outfile, "As input in %d reactions:\n", *(net -> split + i) - *(net -> row + i));
         
-        fprintf(outfile, "As output in %d reactions:\n", dummy -> output.n_react);
+        /* loop over input reactions, print reaction index & coefficient */
+        for (k = *(net -> row + i); k < *(net -> split + i); k++) fprintf(outfile, "\t %d with coefficient %g\n", *(net -> col + k) + 1, -*(net -> coeff + k));
         
-        /* initialise coeff to the first element of output.coeff array */
-        coeff = dummy -> output.coeff;
+        fprintf(outfile, "As output in %d reactions:\n", *(net -> row + i + 1) - *(net -> split + i));
         
-        /* loop over output reactions */
-        for (s_dummy = dummy -> output.react; s_dummy < dummy -> output.react + dummy -> output.n_react; s_dummy++){
-            
-            /* print reaction index & coefficient */
-            fprintf(outfile, "\t %d with coefficient %g\n", (int) (*s_dummy - s) + 1, *coeff);
-            
-            /* iterate the coefficient along the output.coeff array */
-            coeff++;
-        }
+        /* loop over output reactions, print reaction index & coefficient */
+        for (k = *(net -> split + i); k < *(net -> row + i + 1); k++) fprintf(outfile, "\t %d with coefficient %g\n", *(net -> col + k) + 1, *(net -> coeff + k));
         
         fprintf(outfile, "\n\n");
     }
 }
 
 /* A function to re-print the reactions, mainly for debug purposes */
-void print_reactions (double *s, int Nreac, metabolite *metabs, int Nmet, FILE *out_file){
+void print_reactions (network *net, FILE *out_file){
     
-    double *dummy_s, **io_r, *c;
-    metabolite *dummy_m;
-    int n_input, n_output;
+    int j, i, k, n_input, n_output;
+    double c;
     
     /* loop over reactions */
-    for (dummy_s = s; dummy_s < s + Nreac; dummy_s++){
+    for (j = 0; j < net -> Nreact; j++){
         
         /* initialise the number of metabolite of input & output */
         n_input = 0;
         n_output = 0;
         
         /* print reaction index */
-        fprintf(out_file, "%d: ", (int)(dummy_s - s) + 1);
+        fprintf(out_file, "%d: ", j + 1);
         
-        /* loop over metabolites & look for reaction dummy_s */
-        for (dummy_m = metabs; dummy_m < metabs + Nmet; dummy_m++){
-            
-            /* initialise c to the first element of input.coeff array */
-            c = dummy_m -> input.coeff;
+        /* loop over metabolites & look for reaction j among their inputs */
+        for (i = 0; i < net -> Nmet; i++){
             
-            /* loop over input reactions of metabolite dummy_m */
-            for (io_r = dummy_m -> input.react; io_r < dummy_m -> input.react + dummy_m -> input.n_react; io_r++){
+            for (k = *(net -> row + i); k < *(net -> split + i); k++){
                 
-                /* if dummy_s is in the reaction list then */
-                if ( *io_r == dummy_s){
+                /* if j is in the reaction list then */
+                if ( *(net -> col + k) == j){
+                    
+                    c = -*(net -> coeff + k);
                     
                     /* if it is not the first input metabolite, we want to print a "+" */
                     if (n_input > 0 ) fprintf(out_file, " + ");
                     
                     /* if coefficient is 1 we don't want to print it out */
                     /* just print the metabolite index */
-                    if (*c == 1.) fprintf(out_file, "%d ", (int)(dummy_m - metabs) + 1 );
+                    if (c == 1.) fprintf(out_file, "%d ", i + 1 );
                     
                     /* otherwise, print the coefficient & metabolite index */
-                    else fprintf(out_file, "(%g) %d ", *c, (int)(dummy_m - metabs) + 1 );
+                    else fprintf(out_file, "(%g) %d ", c, i + 1 );
                     
                     /* update the number of input metabolites */
                     n_input++;
                 }
-                
-                /* iterate the coefficient along the input.coeff array */
-                c++;
-                
             }
         }
         
         /* get to the other side of reaction */
         fprintf(out_file, " --> ");
         
-        /* loop over metabolites & look for reaction dummy_s */
-        for (dummy_m = metabs; dummy_m < metabs + Nmet; dummy_m++){
-            
-            /* initialise c to the first element of output.coeff array */
-            c = dummy_m -> output.coeff;
+        /* loop over metabolites & look for reaction j among their outputs */
+        for (i = 0; i < net -> Nmet; i++){
             
-            /* loop over output reactions of metabolite dummy_m */
-            for (io_r = dummy_m -> output.react; io_r < dummy_m -> output.react + dummy_m -> output.n_react; io_r++){
+            for (k = *(net -> split + i); k < *(net -> row + i + 1); k++){
                 
-                /* if dummy_s is in the reaction list then */
-                if ( *io_r == dummy_s){
+                /* if j is in the reaction list then */
+                if ( *(net -> col + k) == j){
+                    
+                    c = *(net -> coeff + k);
                     
                     /* if it is not the first output metabolite, we want to print a "+" */
                     if (n_output > 0 ) fprintf(out_file, " + ");
                     
                     /* if coefficient is 1 we don't want to print it out */
                     /* just print the metabolite index */
-                    if (*c == 1.) fprintf(out_file, "%d + ", (int)(dummy_m - metabs) + 1);
+                    if (c == 1.) fprintf(out_file, "%d ", i + 1);
                     
                     /* otherwise, print the coefficient & metabolite index */
-                    else fprintf(out_file, "(%g) %d + ", *c, (int)(dummy_m - metabs) + 1);
+                    else fprintf(out_file, "(%g) %d ", c, i + 1);
                     
-                    /* update the number of input metabolites */
-                    n_input++;
+                    /* update the number of output metabolites */
+                    n_output++;
                     
                 }
-                
-                /* iterate the coefficient along the output.coeff array */
-                c++;
-                
             }
         }
         
@@ -244,41 +162,17 @@ void print_reactions (double *s, int Nreac, metabolite *metabs, int Nmet, FILE *
 
 
 /* A function to print the von Neumann constraints, mainly to check everithing is >= 0. */
-void print_constraints (double *s, metabolite *metabs, int Nmet, double rho, FILE *outfile){
+void print_constraints (double *s, network *net, double rho, FILE *outfile){
     
-    metabolite *dummy_m;
-    double c, *coeff, **s_d;
+    double *c = (double *) malloc( net -> Nmet * sizeof (double) );
+    int i;
     
-    /*loop over metabolites*/
-    for (dummy_m = metabs; dummy_m < metabs + Nmet; dummy_m++){
-        
-        c=0;
-        
-        /* loop over (input) reactions attached to the metabolite dummy_m */
-        coeff = dummy_m -> input.coeff;
-        
-        for (s_d = dummy_m -> input.react; s_d < dummy_m -> input.react + dummy_m -> input.n_react; s_d++){
-            
-            /* calculate negative contribution to constraint */
-            c -= **s_d * (*coeff) * rho;
-            
-            coeff++;
-        }
-        
-        /* loop over (output) reactions attached to the metabolite dummy_m */
-        coeff = dummy_m -> output.coeff;
-        
-        for (s_d = dummy_m -> output.react; s_d < dummy_m -> output.react + dummy_m -> output.n_react; s_d++){
-            
-            /* calculate positive contribution to constraint (rho does not affect it) */
-            c += **s_d * (*coeff);
-            
-            coeff++;
-        }
-        
-        fprintf (outfile, "Metabolite %d c %g\n", (int) (dummy_m - metabs), c);
-        
-    }
+    /* the constraints of all metabolites */
+    constraint_values (net, s, rho, 1., NULL, c);
+    
+    for (i = 0; i < net -> Nmet; i++) fprintf (outfile, "Metabolite %d c %g\n", i, *(c + i));
+    
+    free (c);
 }
 
 /* A function to print the flux values */
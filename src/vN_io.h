@@ -21,16 +21,17 @@
 #include <math.h>
 
 #include "metabolites.h"
+#include "constraints.h"
 
-void print_matrix (metabolite *, int, double *, int, FILE *);
+void print_matrix (network *, FILE *);
 
-void print_adj_list (metabolite *, int, double *, FILE *);
+void print_adj_list (network *, FILE *);
 
-void print_system (metabolite *, int, double *, FILE *);
+void print_system (network *, FILE *);
 
-void print_reactions (double *, int, metabolite *, int, FILE *);
+void print_reactions (network *, FILE *);
 
-void print_constraints (double *, metabolite *, int, double, FILE *);
+void print_constraints (double *, network *, double, FILE *);
 
 void print_fluxes (double *, int, FILE *);
 
@@ -16,6 +16,7 @@
 #ifndef __V_NEUMANN_LIB___
 #define __V_NEUMANN_LIB___
 
+#include "arena.h"
 #include "metabolites.h"
 #include "vN_io.h"
 #include "alloc_system.h"
@@ -24,5 +25,11 @@
 #include "file_wrapper.h"
 #include "cascades.h"
 #include "optimal_flux.h"
+#include "solver_options.h"
+#include "rng.h"
+#include "presolve.h"
+#include "rho_bounds.h"
+#include "flux_state.h"
+#include "constraints.h"
 
 #endif
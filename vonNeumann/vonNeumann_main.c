@@ -19,9 +19,14 @@
 #include <time.h>
 #include <string.h>
 #include <unistd.h>
+#include <getopt.h>
 
 #include "vonNeumann.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 #ifndef LOG_FILE
 #define LOG_FILE "von_Neumann.log"
@@ -71,16 +76,34 @@ void print_help () {
     
     printf ("\n");
     printf ("\tThe following options are available:\n");
+    printf ("\t-A Auto bracket: bound the maximal rho with short relaxed solves, and use the bounds as RHO_INIT and RHO_MAX (unless given), with INIT_STEP_SIZE a hundredth of the bracket (unless given).\n");
+    printf ("\t-a Adaptive schedule: set the rho step, eta and MAX_STEP from the steps and the violation of the previous minover runs.\n");
+    printf ("\t-B [K] Block minOver: fix the K most violated constraints of each scan together (0 for all the violated ones). Default K=1.\n");
+    printf ("\t-b Bisection: search the maximal rho by bisection between RHO_INIT and RHO_MAX, down to MIN_STEP_SIZE.\n");
+    printf ("\t-c [POINTS] Continuation: before each minover run, extrapolate the fluxes from the last POINTS (2 to %d) accepted rho values.\n", FLUX_PATH_MAX);
+    printf ("\t-d [DAMPING] Multiply the steps of a block (see -B) by DAMPING, to keep the updates stable. Default DAMPING=1.\n");
+    printf ("\t-E Exact engine: check each rho of the bisection (implied) with a dense simplex, skipping minover on infeasible ones and restarting it half way to the simplex fluxes on feasible ones it fails on. Not for networks whose tableau (reactions x (metabolites + reactions)) exceeds %g doubles, nor with -k.\n", LP_MAX_TABLEAU);
     printf ("\t-e [ETA] Specify the factor eta for the update step. Default ETA=%g.\n", ETA);
     printf ("\t-h: print this help and exit.\n");
+    printf ("\t-i Incremental minOver: cache the constraints and update only those touched by each step.\n");
+    printf ("\t-j [JOBS] Compute JOBS solutions at the same time, each with its own random stream. Output is in solution order, and -v prints no progress lines when JOBS > 1. Default JOBS=1.\n");
+    printf ("\t-k [K] K-section: like -b, but test K values of rho at the same time (one per thread), shrinking the bracket K+1 times per round.\n");
     printf ("\t-L \"...\" Lock reactions. A comma separated list of reaction indices : lock values parameters must be provided in apices.\n");
     printf ("\t-M [MAX_STEP] Fix the maximum number of steps of minOver algorithm. Default MAX_STEP=%g.\n", N_STEP_MAX);
+    printf ("\t-m [BETA] Momentum: each minover step adds BETA times the previous one, restarting whenever the total violation rises. Default BETA=0.\n");
+    printf ("\t-N Use the Nesterov form of the momentum (see -m).\n");
     printf ("\t-n [N_SOL] Specify the number of solutions. Default N_SOL=%d.\n", N_SOL);
     printf ("\t-o [FILE] Specify the output file. Default stdout.\n");
+    printf ("\t-P Presolve: drop the metabolites that are only produced and the reactions that appear in no constraint, fold the locked reactions into constant terms and merge identical reactions before sampling. Output fluxes refer to the original reactions.\n");
+    printf ("\t-p [RULE] The constraint each minover step fixes: argmin (the most violated one), cyclic (sweeps over the metabolites in order) or random (sweeps in random order). Default RULE=argmin.\n");
     printf ("\t-r [RHO_INIT] Specify the initial rho value. Default RHO_INIT=%g.\n", RHO_INIT);
     printf ("\t-R [RHO_MAX] Specify maximum rho value. Default RHO_MAX=%g.\n", RHO_MAX);
     printf ("\t-S [INIT_STEP_SIZE] Specify the size of the initial step used to update fluxes. Default INIT_STEP_SIZE=%g.\n", STEP_INIT);
+    printf ("\t--seed [SEED] Seed the random number generator, to reproduce a run. Default: the current time.\n");
     printf ("\t-s [MIN_STEP_SIZE] Specify the minimum step size that can be handled by minOver. Default MIN_STEP_SIZE=%g.\n", STEP_MIN);
+    printf ("\t-t [THREADS] Scan the constraints with up to THREADS threads; small networks stay on one core. Default THREADS=1.\n");
+    printf ("\t-w [WINDOW] Give up a minover run when the worst violation has not shrunk over 3 windows of WINDOW steps (the worst violation of a sweep, for the cyclic and random rules), instead of running MAX_STEP steps. Default: never.\n");
+    printf ("\t-x [RELAX] Exact step: each minover update fixes the violated constraint exactly, times the relaxation factor RELAX (e.g. 1). ETA is then only used as the smallest step.\n");
     printf ("\t-v Verbose. Print logfile to stderr instead of %s.\n\n", LOG_FILE);
     
     printf ("Note:\n");
@@ -89,23 +112,43 @@ void print_help () {
 
 int main (int argc, char *argv[] ){
     
-    int c, vflag = 0, Lflag = 0, nflag = 0, Sflag = 0, sflag = 0, Mflag = 0, rflag = 0, Rflag = 0, eflag = 0, oflag = 0;
+    int c, vflag = 0, Sflag = 0, rflag = 0, Rflag = 0, Aflag = 0, Pflag = 0;
     
-    char *LOCKED;
+    char *LOCKED = NULL;
     
     int Nreact, Nmetabs, n_locked = 0, n_null=0, n_null_final;
     
-    int sol, n_sol = N_SOL, n_step_max = N_STEP_MAX;
+    int sol, n_sol = N_SOL, n_step_max = N_STEP_MAX, n_jobs = 1, next_sol = 0;
+    
+    unsigned long seed = (unsigned long) time (NULL);
+    
+    rng_state *streams;
+    
+    /* the options that only have a long name */
+    static struct option long_options[] = {
+        {"seed", required_argument, NULL, 256},
+        {NULL, 0, NULL, 0}
+    };
+    
+    double step_init = STEP_INIT, step_min = STEP_MIN, rho_init = RHO_INIT, rho_max = RHO_MAX, eta = ETA, rho_lo, rho_hi;
+    
+    double *lock_v = (double *)NULL, rho;
+    
+    int *s_locked = (int *)NULL, *s_null = (int *)NULL;
+    
+    FILE *log_file = stderr, *out_file = stdout;
     
-    double step_init = STEP_INIT, step_min = STEP_MIN, rho_init = RHO_INIT, rho_max = RHO_MAX, eta = ETA;
+    solver_options opt;
     
-    double *s, *s_backup, **s_locked = (double **)NULL, *lock_v = (double *)NULL, **s_null = (double **)NULL, rho;
+    presolve_map map;
     
-    FILE *log_file, *out_file = stdout;
+    cascade_report cascades;
+    
+    solver_options_init (&opt);
     
     
     /* parse command line options */
-    while ((c = getopt (argc, argv, "vhL:n:S:s:M:r:R:e:o:")) != -1) {
+    while ((c = getopt_long (argc, argv, "vhAabB:c:d:Eij:k:L:m:Nn:S:s:M:o:Pp:r:R:e:t:w:x:", long_options, NULL)) != -1) {
         switch (c) {
             
                 /* help flag */
@@ -115,20 +158,96 @@ int main (int argc, char *argv[] ){
                 exit (0);
                 break;
                 
+                /* auto flag, bracket the maximal rho before the search */
+            case 'A':
+                
+                Aflag = 1;
+                
+                break;
+                
+                /* adaptive flag, let the schedule controller adapt to the minover runs */
+            case 'a':
+                
+                opt.schedule = VN_SCHEDULE_ADAPTIVE;
+                
+                break;
+                
+                /* bisection flag, search the maximal rho by bisection */
+            case 'b':
+                
+                opt.search = VN_SEARCH_BISECTION;
+                
+                break;
+                
+                /* block flag, fix several constraints per scan */
+            case 'B':
+                
+                opt.block_size = atoi ( optarg );
+                
+                break;
+                
+                /* continuation flag, predict the fluxes at each new rho */
+            case 'c':
+                
+                opt.continuation = atoi ( optarg );
+                
+                /* a single point has nothing to extrapolate */
+                if ( opt.continuation < 2 || opt.continuation > FLUX_PATH_MAX ){
+                    
+                    fprintf(stderr, "The continuation (-c) extrapolates from 2 to %d points, not %s\n", FLUX_PATH_MAX, optarg);
+                    
+                    exit (EXIT_FAILURE);
+                }
+                
+                break;
+                
+                /* damping flag, scale the steps of a block */
+            case 'd':
+                
+                opt.damping = atof ( optarg );
+                
+                break;
+                
+                /* exact flag, check each rho of the bisection with the simplex */
+            case 'E':
+                
+                opt.exact = 1;
+                
+                break;
+                
                 /* eta flag -- fix step factor size */
             case 'e':
                 
-                eflag = 1;
-                
                 eta = atof ( optarg );
                 
                 break;
 
+                /* incremental flag, cache the constraints inside minover */
+            case 'i':
+                
+                opt.incremental = 1;
+                
+                break;
+                
+                /* jobs flag, compute several solutions at the same time */
+            case 'j':
+                
+                n_jobs = atoi ( optarg );
+                
+                break;
+                
+                /* k-section flag, test several rho values at once */
+            case 'k':
+                
+                opt.search = VN_SEARCH_KSECTION;
+                
+                opt.search_workers = atoi ( optarg );
+                
+                break;
+                
                 /* lock flag, fix locked reactions */
             case 'L' :
-                Lflag = 1;
-                
-                LOCKED = (char *) malloc( strlen(optarg)*sizeof(char) );
+                LOCKED = (char *) malloc( (strlen(optarg) + 1)*sizeof(char) );
                 strcpy(LOCKED , optarg);
                 n_locked = get_n_locked (LOCKED);
                 
@@ -137,17 +256,27 @@ int main (int argc, char *argv[] ){
                 /* step max flag, fix the maximum number of steps for minover */
             case 'M':
                 
-                Mflag = 1;
-                
                 n_step_max = atoi ( optarg );
                 
                 break;
 
+                /* momentum flag, accelerate minover */
+            case 'm':
+                
+                opt.momentum = atof ( optarg );
+                
+                break;
+                
+                /* Nesterov flag, use the Nesterov form of the momentum */
+            case 'N':
+                
+                opt.nesterov = 1;
+                
+                break;
+                
                 /* nsol flag, fix the number of solutions */
             case 'n':
                 
-                nflag = 1;
-                
                 n_sol = atoi ( optarg );
                 
                 break;
@@ -155,12 +284,35 @@ int main (int argc, char *argv[] ){
                 /* output flag, specify the output file */
             case 'o':
                 
-                oflag = 1;
-                
                 out_file = fopen( optarg, "w");
                 
                 break;
             
+                /* presolve flag, shrink the network before sampling */
+            case 'P':
+                
+                Pflag = 1;
+                
+                break;
+                
+                /* selection flag, choose the constraint fixed at each minover step */
+            case 'p':
+                
+                if ( strcmp (optarg, "argmin") == 0 ) opt.selection = VN_SELECT_ARGMIN;
+                
+                else if ( strcmp (optarg, "cyclic") == 0 ) opt.selection = VN_SELECT_CYCLIC;
+                
+                else if ( strcmp (optarg, "random") == 0 ) opt.selection = VN_SELECT_RANDOM;
+                
+                else {
+                    
+                    fprintf(stderr, "Unknown selection rule %s (argmin, cyclic or random)\n", optarg);
+                    
+                    exit (EXIT_FAILURE);
+                }
+                
+                break;
+                
                 /* rho init flag, fix the initial value of rho */
             case 'r':
                 
@@ -191,12 +343,40 @@ int main (int argc, char *argv[] ){
                 /* step min flag, fix the minimum step size */
             case 's':
                 
-                sflag = 1;
-                
                 step_min = atof ( optarg );
 
                 break;
                 
+                /* threads flag, scan the constraints in parallel */
+            case 't':
+                
+                opt.n_threads = atoi ( optarg );
+                
+                break;
+                
+                /* window flag, give up minover runs that stopped converging */
+            case 'w':
+                
+                opt.stall_window = atoi ( optarg );
+                
+                break;
+                
+                /* exact step flag, fix the violated constraint exactly at each update */
+            case 'x':
+                
+                opt.update = VN_UPDATE_EXACT;
+                
+                opt.relaxation = atof ( optarg );
+                
+                break;
+                
+                /* seed flag, fix the seed of the random number generator */
+            case 256:
+                
+                seed = strtoul ( optarg, NULL, 10 );
+                
+                break;
+                
                 /* verbose flag, print log to stderr */
             case 'v' :
                 vflag = 1;
@@ -211,6 +391,40 @@ int main (int argc, char *argv[] ){
         }
     };
     
+    /* the exact engine works inside the bisection */
+    if ( opt.exact && opt.search == VN_SEARCH_KSECTION ){
+        
+        fprintf (stderr, "The exact engine (-E) cannot be combined with the k-section (-k)\n");
+        
+        exit (EXIT_FAILURE);
+    }
+    
+    if ( opt.exact ) opt.search = VN_SEARCH_BISECTION;
+    
+    /* the sweeps fix one constraint at a time, from the fluxes themselves */
+    if ( opt.selection != VN_SELECT_ARGMIN && (opt.block_size != 1 || opt.momentum > 0. || opt.incremental) ){
+        
+        fprintf (stderr, "The cyclic and random rules (-p) cannot be combined with -B, -m or -i\n");
+        
+        exit (EXIT_FAILURE);
+    }
+    
+    /* the candidates of the k-section take the threads the jobs would run on */
+    if ( opt.search == VN_SEARCH_KSECTION && n_jobs > 1 ){
+        
+        fprintf (stderr, "The k-section (-k) cannot be combined with several jobs (-j)\n");
+        
+        exit (EXIT_FAILURE);
+    }
+    
+    /* blocks and momentum scan all the constraints at each step, without the cache */
+    if ( (opt.block_size != 1 || opt.momentum > 0.) && opt.incremental ){
+        
+        fprintf (stderr, "Incremental minOver (-i) cannot be combined with -B or -m\n");
+        
+        exit (EXIT_FAILURE);
+    }
+    
     /* check that we have the right number of arguments */
     if (optind+1!=argc) {
         fprintf (stderr, "Incorrect usage...\n");
@@ -222,9 +436,17 @@ int main (int argc, char *argv[] ){
     /* if not verbose, open the log file */
     if (vflag == 0) log_file = fopen(LOG_FILE, "w");
     
-    /* open the input file and store it into the file_wrappwer structure */
+    /* select the constraint kernels for this CPU, once and before any parallel region */
+    constraints_init ();
+    
+    /* open the input file and guess its type */
    file_wrapper *input_data = handle_input_file (argv[ argc - 1], 10, log_file);
     
+    /* allocate space for the network structure, reading the input file once */
+    network net;
+    
+    alloc_system (input_data, &net, log_file);
+    
     /* retrieve the number of reactions and metabolites from the file_wrapper struct */
     Nreact = input_data -> Nreact;
     
@@ -233,48 +455,37 @@ int main (int argc, char *argv[] ){
     /* keep track of everything in the log file */
     fprintf(log_file, "The system has %d metabolites and %d Reactions\n", Nmetabs, Nreact);
     
-    /* allocate reactions */
-    s = (double *) malloc ( Nreact * sizeof(double) );
-    
-    /* allocate space to backup reactions */
-    s_backup = (double *) malloc ( Nreact * sizeof(double) );
-    
-    /* allocate space for metabolite structure */
-    metabolite *metabs;
-    
-    metabs = (metabolite *) malloc( Nmetabs * sizeof (metabolite) );
-    
-    alloc_system (input_data, metabs, Nmetabs, s, log_file);
-    
     /* free the file wrapper structure */
     file_wrapper_free(&input_data);
     
     /* if locking some reactions */
     if ( n_locked > 0 ){
         
-        /* create an array of pointers associated to the locked reactions */
-        s_locked = (double **) malloc ( n_locked*sizeof(double*) );
+        /* create an array with the indices of the locked reactions */
+        s_locked = (int *) malloc ( n_locked*sizeof(int) );
         
         /* and the lock value */
         lock_v = (double *) malloc ( n_locked*sizeof(double) );
         
         /* get also the number of zero reactions (they can be effectively removed from the system) */
-        n_null = fix_locked (n_locked, s, s_locked, lock_v, LOCKED);
+        n_null = fix_locked (n_locked, s_locked, lock_v, LOCKED);
         
         /* if there are zero reactions, remove them */
         if ( n_null > 0) s_null = assign_null_reactions (s_locked, lock_v, n_null, n_locked);
     }
  
     /* check feasibility of the system, i.e. whether there are metabolites that are only consumed */
-    n_null_final = check_cascades (metabs, Nmetabs, &s_null, n_null, s, log_file);
+    n_null_final = check_cascades (&net, &s_null, n_null, &cascades);
+    
+    fprintf(log_file, "%d null reactions, %d more forced to zero by %d metabolites only consumed, %d entries removed\n", cascades.n_given, cascades.n_forced, cascades.n_dead, cascades.n_removed);
     
     /* if to make the system feasible, some reactions have been forced to zero... */
     if ( n_null_final != n_null){
         
         /* realloc the null reactions and values */
-        s_locked = (double **) realloc (s_locked, n_locked + (n_null_final - n_null) * sizeof(double*) );
+        s_locked = (int *) realloc (s_locked, (n_locked + n_null_final - n_null) * sizeof(int) );
         
-        lock_v = (double *) realloc (lock_v, n_locked + (n_null_final - n_null) * sizeof(double) );
+        lock_v = (double *) realloc (lock_v, (n_locked + n_null_final - n_null) * sizeof(double) );
         
         /* keep track of all locked reactions */
         n_locked = update_null_reactions (s_locked, lock_v, n_null, n_null_final, n_locked, s_null);
@@ -283,48 +494,132 @@ int main (int argc, char *argv[] ){
     
     /* keep track of everything in the log file */
     fprintf(log_file, "\n\nThe system has %d locked reactions (%d of them null)\n", n_locked, n_null_final);
+    
+    /* shrink the network, the locked reactions are replaced by those of the reduced one */
+    if ( Pflag ) Pflag = presolve (&net, &map, &s_locked, &lock_v, &n_locked, log_file);
+    
+    /* the exact engine keeps a dense tableau of the (presolved) network */
+    if ( opt.exact && lp_tableau_size (&net) > LP_MAX_TABLEAU ){
+        
+        fprintf (stderr, "The network is too large for the exact engine (-E): its simplex tableau would hold %g doubles, more than %g\n", lp_tableau_size (&net), LP_MAX_TABLEAU);
+        
+        exit (EXIT_FAILURE);
+    }
+    
+    fprintf(log_file, "Constraints evaluated with the %s kernel\n", constraint_kernel_name ());
 
-    /* initialise the random number generator */
-    srand48( time (NULL) );
+    fprintf(log_file, "Random seed %lu\n", seed);
     
-    /* for non verbose output */
-    /* for n_sol times */
-    for (sol = 0; sol < n_sol * (1-vflag); sol++) {
+    /* bracket the maximal rho, to start and cap the search */
+    if ( Aflag ){
+        
+        if ( rho_bracket (&net, s_locked, n_locked, lock_v, &rho_lo, &rho_hi) ){
+            
+            fprintf(log_file, "The maximal rho is within [%g, %g]\n", rho_lo, rho_hi);
+            
+            if ( Rflag == 0 && rho_hi < HUGE_VAL ) rho_max = rho_hi;
+            
+            /* a lower bound that is unbounded (no metabolite consumed) or past rho_max cannot start the search */
+            if ( rflag == 0 && isfinite (rho_lo) && rho_lo <= rho_max ) rho_init = rho_lo;
+            
+            if ( Sflag == 0 && (rho_max - rho_init) / 100. > step_min ) step_init = (rho_max - rho_init) / 100.;
+        }
         
-        /* sample reactions up to the maximum rho */
-        rho = optimal_flux (metabs, s, s_locked, n_locked, lock_v , s_backup, Nmetabs, Nreact, n_step_max, step_init, step_min, rho_init, rho_max, eta);
+        else fprintf(log_file, "The maximal rho cannot be bracketed with reactions locked at non-zero values\n");
+    }
     
-        /* keep track to the max rho (may be smaller than rho_max if the step decreases too much) */
-        fprintf(log_file, "Solution %d, rho = %g\n", sol+1, rho);
+    /* the random streams: solution sol uses stream sol, whatever the number of jobs */
+    streams = (rng_state *) malloc ( (n_sol > 0 ? n_sol : 1) * sizeof(rng_state) );
+    
+    rng_seed (streams, seed);
+    
+    for (sol = 1; sol < n_sol; sol++){
+        
+        *(streams + sol) = *(streams + sol - 1);
         
-        /* print the fluxes sampled at max rho */
-        print_fluxes (s, Nreact, out_file);
+        rng_jump (streams + sol);
     }
     
-    /* for verbose output */
-    for (sol = 0; sol < n_sol*vflag; sol++) {
+    /* the network is shared by all solves and only read from now on: the incremental minover needs its transpose */
+    if ( opt.incremental ) network_transpose (&net);
+    
+    /* the solutions computed, until all the previous ones are printed, and their rho */
+    double **s_done = (double **) calloc ( n_sol, sizeof(double *) ), *rho_done = (double *) malloc ( n_sol * sizeof(double) );
+    
+    if ( n_jobs < 1 ) n_jobs = 1;
+    
+    /* each job has its own fluxes, backup and random stream */
+#ifdef _OPENMP
+#pragma omp parallel num_threads(n_jobs) private(rho)
+#endif
+    {
+        flux_state fs;
         
-        /* sample reactions up to the maximum rho */
-        rho = optimal_flux_verbose (metabs, s, s_locked, n_locked, lock_v , s_backup, Nmetabs, Nreact, n_step_max, step_init, step_min, rho_init, rho_max, eta, log_file);
+        flux_state_alloc (&fs, net.Nreact, n_locked, s_locked, lock_v);
         
-        /* keep track to the max rho (may be smaller than rho_max if the step decreases too much) */
-        fprintf(log_file, "Solution %d, rho = %g\n", sol+1, rho);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+        for (sol = 0; sol < n_sol; sol++) {
+            
+            fs.rng = *(streams + sol);
+            
+            /* sample reactions up to the maximum rho (the progress lines of concurrent jobs would overwrite each other) */
+            if ( vflag && n_jobs == 1 ) rho = optimal_flux_verbose (&net, &fs, n_step_max, step_init, step_min, rho_init, rho_max, eta, &opt, log_file);
+            
+            else rho = optimal_flux (&net, &fs, n_step_max, step_init, step_min, rho_init, rho_max, eta, &opt);
+            
+            /* store the solution and print all those that are next in order */
+#ifdef _OPENMP
+#pragma omp critical (vn_output)
+#endif
+            {
+                *(s_done + sol) = (double *) malloc ( Nreact * sizeof(double) );
+                
+                /* in terms of the original reactions */
+                if ( Pflag ) presolve_expand (&map, fs.s, *(s_done + sol) );
+                
+                else memcpy (*(s_done + sol), fs.s, Nreact * sizeof(double) );
+                
+                *(rho_done + sol) = rho;
+                
+                for (; next_sol < n_sol && *(s_done + next_sol) != NULL; next_sol++){
+                    
+                    /* keep track to the max rho (may be smaller than rho_max if the step decreases too much) */
+                    fprintf(log_file, "Solution %d, rho = %g\n", next_sol + 1, *(rho_done + next_sol));
+                    
+                    /* print the fluxes sampled at max rho */
+                    print_fluxes (*(s_done + next_sol), Nreact, out_file);
+                    
+                    free (*(s_done + next_sol));
+                }
+            }
+        }
         
-        /* print the fluxes sampled at max rho */
-        print_fluxes (s, Nreact, out_file);
+        flux_state_free (&fs);
     }
     
+    free (s_done);
+    
+    free (rho_done);
+    
+    free (streams);
+    
     /* close output files */
     if (log_file != stderr) fclose(log_file);
     
     if (out_file != stdout) fclose(out_file);
     
     /* free the system */
-    free (s);
+    free (s_locked);
+    
+    free (lock_v);
+    
+    free (s_null);
     
-    free (s_backup);
+    network_free (&net);
     
-    metabolite_free (&metabs, Nmetabs);
+    if ( Pflag ) presolve_free (&map);
         
     return 0;
 